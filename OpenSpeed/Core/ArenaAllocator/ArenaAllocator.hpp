@@ -0,0 +1,273 @@
+// clang-format off
+//
+//    ArenaAllocator: Header-only bump arenas, per-frame arenas and node pools that plug into EASTL containers. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <algorithm>  // max
+#include <cstddef>    // size_t, byte, max_align_t
+#include <cstdint>    // uintptr_t
+#include <memory>     // unique_ptr
+#include <new>        // operator new, operator delete
+#include <vector>     // vector
+
+namespace ArenaAllocator {
+  // Memory is only taken from the heap when an arena or pool has to grow. Once they have seen a typical frame,
+  // allocating and resetting costs a few instructions and no heap calls.
+  // None of these are thread-safe, give each thread its own.
+
+  static constexpr std::size_t kDefaultAlignment = alignof(std::max_align_t);
+
+  namespace details {
+    inline std::uintptr_t AlignUp(std::uintptr_t value, std::size_t alignment) {
+      return (value + alignment - 1) & ~static_cast<std::uintptr_t>(alignment - 1);
+    }
+
+    struct Block {
+      std::unique_ptr<std::byte[]> mData;
+      std::size_t                  mSize;
+    };
+  }  // namespace details
+
+  // Bump allocator over a list of blocks. Deallocation is a no-op, everything is released at once by Reset().
+  // Usage: ArenaAllocator::Arena arena(64 * 1024); auto* p = arena.Allocate(size); ... arena.Reset();
+  class Arena {
+    std::vector<details::Block> mBlocks;
+    std::size_t                 mBlockSize;
+    std::size_t                 mBlock  = 0;
+    std::size_t                 mOffset = 0;
+    std::size_t                 mUsed   = 0;
+    std::size_t                 mPeak   = 0;
+
+    void AddBlock(std::size_t size) { mBlocks.push_back({std::make_unique<std::byte[]>(size), size}); }
+
+   public:
+    explicit Arena(std::size_t blockSize = 64 * 1024) : mBlockSize(blockSize) {}
+    Arena(const Arena&)            = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // 'size' bytes such that (result + offset) is aligned to 'alignment' (a power of two), EASTL style
+    void* Allocate(std::size_t size, std::size_t alignment = kDefaultAlignment, std::size_t offset = 0) {
+      for (;;) {
+        if (mBlock == mBlocks.size()) AddBlock(std::max(mBlockSize, size + alignment + offset));
+
+        const auto& block = mBlocks[mBlock];
+        const auto  base  = reinterpret_cast<std::uintptr_t>(block.mData.get());
+        const auto  start = details::AlignUp(base + mOffset + offset, alignment) - offset;
+        if (start + size <= base + block.mSize) {
+          mUsed   += start + size - (base + mOffset);
+          mOffset  = start + size - base;
+          mPeak    = std::max(mPeak, mUsed);
+          return reinterpret_cast<void*>(start);
+        }
+
+        // The rest of this block is wasted until the next Reset()
+        mBlock++;
+        mOffset = 0;
+      }
+    }
+    template <typename T>
+    T* Allocate(std::size_t count = 1) {
+      return static_cast<T*>(Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // Forget every allocation. If the last cycle needed more than one block they are merged into one, so the
+    // arena settles on a single block big enough for a whole cycle.
+    void Reset() {
+      if (mBlocks.size() > 1) {
+        std::size_t size = 0;
+        for (const auto& block : mBlocks) size += block.mSize;
+
+        mBlocks.clear();
+        AddBlock(size);
+      }
+      mBlock  = 0;
+      mOffset = 0;
+      mUsed   = 0;
+    }
+
+    // Bytes handed out since the last Reset(), padding included
+    std::size_t GetUsed() const { return mUsed; }
+    // Highest GetUsed() ever seen
+    std::size_t GetPeak() const { return mPeak; }
+    std::size_t GetCapacity() const {
+      std::size_t size = 0;
+      for (const auto& block : mBlocks) size += block.mSize;
+      return size;
+    }
+  };
+
+  // Arena that resets itself the first time it is used in a new frame. Nothing allocated from it may be kept
+  // past the frame it was allocated in.
+  // Usage: auto& arena = frameArena.Begin(FrameEx::GetFrame());
+  class FrameArena {
+    Arena         mArena;
+    std::uint32_t mFrame    = 0;
+    bool          mHasFrame = false;
+
+   public:
+    explicit FrameArena(std::size_t blockSize = 64 * 1024) : mArena(blockSize) {}
+
+    Arena& Begin(std::uint32_t frame) {
+      if (!mHasFrame || mFrame != frame) {
+        mArena.Reset();
+        mFrame    = frame;
+        mHasFrame = true;
+      }
+      return mArena;
+    }
+    // The arena as it is, without checking the frame
+    Arena& Get() { return mArena; }
+  };
+
+  // Free list of equally sized nodes, for node based containers (eastl::list, eastl::map) that free and allocate
+  // one node at a time. Nodes are carved from blocks of 'nodesPerBlock' that are only returned on destruction.
+  // Usage: auto pool = ArenaAllocator::Pool::For<eastl::list<int, ArenaAllocator::EASTLPoolAllocator>>();
+  class Pool {
+    struct FreeNode {
+      FreeNode* mNext;
+    };
+
+    std::vector<details::Block> mBlocks;
+    FreeNode*                   mFree = nullptr;
+    std::size_t                 mNodeSize;
+    std::size_t                 mNodeAlignment;
+    std::size_t                 mNodesPerBlock;
+    std::size_t                 mCount = 0;
+
+    void AddBlock() {
+      const auto size = mNodeSize * mNodesPerBlock + mNodeAlignment;
+      mBlocks.push_back({std::make_unique<std::byte[]>(size), size});
+
+      auto node = details::AlignUp(reinterpret_cast<std::uintptr_t>(mBlocks.back().mData.get()), mNodeAlignment);
+      for (std::size_t i = 0; i < mNodesPerBlock; i++, node += mNodeSize) {
+        auto* free  = reinterpret_cast<FreeNode*>(node);
+        free->mNext = mFree;
+        mFree       = free;
+      }
+    }
+
+   public:
+    Pool(std::size_t nodeSize, std::size_t nodeAlignment = kDefaultAlignment, std::size_t nodesPerBlock = 256)
+        : mNodeAlignment(std::max(nodeAlignment, alignof(FreeNode))),
+          mNodesPerBlock(std::max<std::size_t>(nodesPerBlock, 1)) {
+      mNodeSize = details::AlignUp(std::max(nodeSize, sizeof(FreeNode)), mNodeAlignment);
+    }
+    Pool(const Pool&)            = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    // Pool sized for the nodes of an EASTL node container
+    template <typename Container>
+    static Pool For(std::size_t nodesPerBlock = 256) {
+      using Node = typename Container::node_type;
+      return Pool(sizeof(Node), alignof(Node), nodesPerBlock);
+    }
+
+    bool CanAllocate(std::size_t size) const { return size <= mNodeSize; }
+
+    void* Allocate() {
+      if (!mFree) AddBlock();
+
+      auto* node = mFree;
+      mFree      = node->mNext;
+      mCount++;
+      return node;
+    }
+    void Deallocate(void* node) {
+      auto* free  = static_cast<FreeNode*>(node);
+      free->mNext = mFree;
+      mFree       = free;
+      mCount--;
+    }
+
+    std::size_t GetNodeSize() const { return mNodeSize; }
+    // Nodes currently handed out
+    std::size_t GetCount() const { return mCount; }
+    std::size_t GetCapacity() const { return mBlocks.size() * mNodesPerBlock; }
+  };
+
+  // EASTL allocators. Containers default-construct their allocator from a name, so without an arena/pool these
+  // fall back to the heap (default new alignment only); pass one in the container's constructor instead:
+  // Usage: eastl::vector<int, ArenaAllocator::EASTLArenaAllocator> v{ArenaAllocator::EASTLArenaAllocator{&arena}};
+  namespace details {
+    inline void* HeapAllocate(std::size_t size) { return ::operator new(size); }
+    inline void  HeapDeallocate(void* p) { ::operator delete(p); }
+  }  // namespace details
+
+  // Allocates from an Arena, deallocate() is a no-op. Growing an arena vector leaves its old buffer behind until
+  // the arena resets, so reserve() up front when the size is known.
+  class EASTLArenaAllocator {
+    Arena*      mArena = nullptr;
+    const char* mpName;
+
+   public:
+    explicit EASTLArenaAllocator(const char* pName = "ArenaAllocator") : mpName(pName) {}
+    explicit EASTLArenaAllocator(Arena* arena, const char* pName = "ArenaAllocator") : mArena(arena), mpName(pName) {}
+    EASTLArenaAllocator(const EASTLArenaAllocator& x, const char* pName) : mArena(x.mArena), mpName(pName) {}
+    EASTLArenaAllocator(const EASTLArenaAllocator&)            = default;
+    EASTLArenaAllocator& operator=(const EASTLArenaAllocator&) = default;
+
+    void* allocate(std::size_t n, int flags = 0) { return allocate(n, kDefaultAlignment, 0, flags); }
+    void* allocate(std::size_t n, std::size_t alignment, std::size_t offset, int = 0) {
+      return mArena ? mArena->Allocate(n, alignment, offset) : details::HeapAllocate(n);
+    }
+    void deallocate(void* p, std::size_t) {
+      if (!mArena) details::HeapDeallocate(p);
+    }
+
+    const char* get_name() const { return mpName; }
+    void        set_name(const char* pName) { mpName = pName; }
+    Arena*      GetArena() const { return mArena; }
+
+    friend bool operator==(const EASTLArenaAllocator& a, const EASTLArenaAllocator& b) { return a.mArena == b.mArena; }
+    friend bool operator!=(const EASTLArenaAllocator& a, const EASTLArenaAllocator& b) { return a.mArena != b.mArena; }
+  };
+
+  // Takes nodes from a Pool and gives them back on deallocate(). Anything the pool can't hold (a bigger or more
+  // aligned request) goes to the heap, decided by size alone so deallocate() always takes the same path.
+  class EASTLPoolAllocator {
+    Pool*       mPool = nullptr;
+    const char* mpName;
+
+    bool IsPooled(std::size_t n) const { return mPool && mPool->CanAllocate(n); }
+
+   public:
+    explicit EASTLPoolAllocator(const char* pName = "PoolAllocator") : mpName(pName) {}
+    explicit EASTLPoolAllocator(Pool* pool, const char* pName = "PoolAllocator") : mPool(pool), mpName(pName) {}
+    EASTLPoolAllocator(const EASTLPoolAllocator& x, const char* pName) : mPool(x.mPool), mpName(pName) {}
+    EASTLPoolAllocator(const EASTLPoolAllocator&)            = default;
+    EASTLPoolAllocator& operator=(const EASTLPoolAllocator&) = default;
+
+    void* allocate(std::size_t n, int = 0) { return IsPooled(n) ? mPool->Allocate() : details::HeapAllocate(n); }
+    // The pool has to be at least as aligned as the nodes, Pool::For() takes care of that
+    void* allocate(std::size_t n, std::size_t, std::size_t, int flags = 0) { return allocate(n, flags); }
+    void deallocate(void* p, std::size_t n) {
+      if (IsPooled(n))
+        mPool->Deallocate(p);
+      else
+        details::HeapDeallocate(p);
+    }
+
+    const char* get_name() const { return mpName; }
+    void        set_name(const char* pName) { mpName = pName; }
+    Pool*       GetPool() const { return mPool; }
+
+    friend bool operator==(const EASTLPoolAllocator& a, const EASTLPoolAllocator& b) { return a.mPool == b.mPool; }
+    friend bool operator!=(const EASTLPoolAllocator& a, const EASTLPoolAllocator& b) { return a.mPool != b.mPool; }
+  };
+}  // namespace ArenaAllocator
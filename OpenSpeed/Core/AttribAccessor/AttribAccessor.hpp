@@ -0,0 +1,147 @@
+// clang-format off
+//
+//    AttribAccessor: A header-only O(1) field table for Attrib classes, built from their definitions. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <cstddef>  // size_t
+#include <cstdint>  // integer types
+#include <cstring>  // memcpy
+#include <vector>   // vector
+
+namespace AttribAccessor {
+  // What a class definition says about one field
+  struct Field {
+    enum Flags : std::uint8_t { Array = 1 << 0, InLayout = 1 << 1 };  // same bits as Attrib::Definition::Flags
+
+    std::uint32_t mKey      = 0;
+    std::uint16_t mOffset   = 0;  // into the collection's layout, meaningful if laid out
+    std::uint16_t mSize     = 0;  // element size
+    std::uint16_t mMaxCount = 0;
+    std::uint8_t  mFlags    = 0;
+
+    bool IsArray() const { return mFlags & Array; }
+    bool IsLaidOut() const { return mFlags & InLayout; }
+  };
+
+  // Laid out arrays start with an Attrib::Private { capacity, count, element size, data }
+  static constexpr std::size_t kArrayHeaderSize  = 8;
+  static constexpr std::size_t kArrayCountOffset = 2;
+  static constexpr std::size_t kNoOffset         = ~std::size_t(0);
+
+  // Number of items a laid out field holds
+  static std::uint32_t GetLayoutCount(const void* layout, const Field& field) {
+    if (!field.IsArray()) return 1;
+
+    std::uint16_t count = 0;
+    std::memcpy(&count, static_cast<const std::uint8_t*>(layout) + field.mOffset + kArrayCountOffset, sizeof(count));
+    return count;
+  }
+  // Offset of item 'idx' of a laid out field from the start of the layout, kNoOffset past its count
+  static std::size_t GetLayoutOffset(const void* layout, const Field& field, std::uint32_t idx) {
+    if (idx >= GetLayoutCount(layout, field)) return kNoOffset;
+    if (!field.IsArray()) return field.mOffset;
+    return field.mOffset + kArrayHeaderSize + std::size_t(idx) * field.mSize;
+  }
+
+  // Open-addressing map from field key to Field, at most half full; built once per class
+  class Table {
+    std::vector<Field> mSlots;  // key 0 marks an empty slot
+    std::uint32_t      mMask       = 0;
+    std::uint32_t      mFieldCount = 0;
+
+    static std::uint32_t Mix(std::uint32_t key) { return (key ^ (key >> 16)) * 0x45D9F3B; }
+
+    void Insert(const Field& field) {
+      for (std::uint32_t idx = Mix(field.mKey);; idx++) {
+        auto& slot = mSlots[idx & mMask];
+        if (slot.mKey && slot.mKey != field.mKey) continue;
+
+        if (!slot.mKey) mFieldCount++;
+        slot = field;
+        return;
+      }
+    }
+
+   public:
+    Table() = default;
+    template <typename Class>
+    explicit Table(Class& cls) {
+      Build(cls);
+    }
+
+    // Works with anything shaped like Attrib::Class, e.g. the game's or VaultReader::Class
+    template <typename Class>
+    void Build(Class& cls) {
+      const std::uint32_t numDefinitions = cls.GetNumDefinitions();
+
+      std::uint32_t size = 8;
+      while (size < numDefinitions * 2) size <<= 1;
+      mSlots.assign(size, Field{});
+      mMask       = size - 1;
+      mFieldCount = 0;
+
+      std::uint32_t key = cls.GetFirstDefinition();
+      for (std::uint32_t i = 0; key && i < numDefinitions; i++, key = cls.GetNextDefinition(key)) {
+        const auto* definition = cls.GetDefinition(key);
+        if (!definition) continue;
+
+        Field field;
+        field.mKey      = definition->mKey;
+        field.mOffset   = definition->mOffset;
+        field.mSize     = definition->mSize;
+        field.mMaxCount = definition->mMaxCount;
+        field.mFlags    = static_cast<std::uint8_t>(definition->mFlags) & (Field::Array | Field::InLayout);
+        if (field.mKey) Insert(field);
+      }
+    }
+
+    std::uint32_t GetFieldCount() const { return mFieldCount; }
+
+    const Field* Find(std::uint32_t key) const {
+      if (!key || mSlots.empty()) return nullptr;
+
+      for (std::uint32_t idx = Mix(key);; idx++) {
+        const auto& slot = mSlots[idx & mMask];
+        if (slot.mKey == key) return &slot;
+        if (!slot.mKey) return nullptr;
+      }
+    }
+
+    // Laid out fields are a pointer add from 'layout', the rest are left to 'fallback', e.g. Collection::GetData
+    // Usage: auto* mass = table.GetData<float>(layout, "MASS"_key, 0, [&] { return c->GetData<float>(key); });
+    template <typename T, typename Fallback>
+    T* GetData(void* layout, std::uint32_t key, std::uint32_t idx, Fallback&& fallback) const {
+      auto* field = Find(key);
+      if (!layout || !field || !field->IsLaidOut()) return fallback();
+
+      auto offset = GetLayoutOffset(layout, *field, idx);
+      return offset != kNoOffset ? reinterpret_cast<T*>(static_cast<std::uint8_t*>(layout) + offset) : nullptr;
+    }
+    template <typename T, typename Fallback>
+    const T* GetData(const void* layout, std::uint32_t key, std::uint32_t idx, Fallback&& fallback) const {
+      return GetData<const T>(const_cast<void*>(layout), key, idx, fallback);
+    }
+    template <typename Fallback>
+    std::uint32_t GetCount(const void* layout, std::uint32_t key, Fallback&& fallback) const {
+      auto* field = Find(key);
+      if (!layout || !field || !field->IsLaidOut()) return fallback();
+      return GetLayoutCount(layout, *field);
+    }
+  };
+}  // namespace AttribAccessor
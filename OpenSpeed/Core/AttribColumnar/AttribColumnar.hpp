@@ -0,0 +1,532 @@
+// clang-format off
+//
+//    AttribColumnar: A header-only columnar exporter and mmap reader for Attrib databases. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <algorithm>      // min, find
+#include <cstdint>        // integer types
+#include <cstring>        // memcpy, memchr
+#include <ostream>        // ostream
+#include <string>         // string
+#include <string_view>    // string_view
+#include <thread>         // thread
+#include <type_traits>    // false_type, integral_constant, void_t
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+#include <OpenSpeed/Core/Hashing/Hashing.hpp>          // Hashing::StringHash32
+#include <OpenSpeed/Core/VaultReader/VaultReader.hpp>  // VaultReader::Database, VaultReader::MappedFile
+#include <OpenSpeed/Core/WorkerPool/WorkerPool.hpp>    // WorkerPool::Pool
+
+namespace AttribColumnar {
+  // File layout: Header, string table, then per class a ClassEntry, row keys and ColumnEntry list.
+  // Every section is 8-byte aligned, positions are absolute file offsets; little-endian.
+  namespace Layout {
+    static constexpr std::uint32_t kMagic   = 0x4341534F;  // OSAC
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr std::uint32_t kNoValue = 0xFFFFFFFF;  // null string id
+
+    enum class ColumnKind : std::uint8_t {
+      Scalar,       // validity[rows], values[rows * elemSize]
+      Array,        // offsets[rows + 1] in elements, values[offsets[rows] * elemSize]
+      String,       // validity[rows], string ids[rows]
+      StringArray,  // offsets[rows + 1], string ids[offsets[rows]]
+    };
+
+    struct Header {
+      std::uint32_t mMagic;
+      std::uint32_t mVersion;
+      std::uint32_t mNumClasses;
+      std::uint32_t mNumStrings;
+      std::uint64_t mStringOffsets;  // u32[mNumStrings + 1], into mStringData
+      std::uint64_t mStringData;
+      std::uint64_t mClasses;  // ClassEntry[mNumClasses]
+    };
+    struct ClassEntry {
+      std::uint32_t mKey;
+      std::uint32_t mNumRows;
+      std::uint32_t mNumColumns;
+      std::uint32_t mPad;
+      std::uint64_t mRowKeys;  // u32[mNumRows], collection keys
+      std::uint64_t mColumns;  // ColumnEntry[mNumColumns]
+    };
+    struct ColumnEntry {
+      std::uint32_t mKey;
+      std::uint32_t mType;
+      std::uint16_t mElemSize;
+      ColumnKind    mKind;
+      std::uint8_t  mPad[5];
+      std::uint64_t mValidity;  // 0 for array kinds
+      std::uint64_t mOffsets;   // 0 for scalar kinds
+      std::uint64_t mValues;
+      std::uint64_t mValuesSize;
+    };
+
+    static_assert(sizeof(Header) == 0x28, "Layout::Header size mismatch.");
+    static_assert(sizeof(ClassEntry) == 0x20, "Layout::ClassEntry size mismatch.");
+    static_assert(sizeof(ColumnEntry) == 0x30, "Layout::ColumnEntry size mismatch.");
+  }  // namespace Layout
+
+  // Options shared by Export() and AttribDiff::Diff()
+  struct SourceOptions {
+    // Definition type keys holding 'const char*'
+    std::vector<std::uint32_t> mStringTypes = {Hashing::StringHash32("char*"), Hashing::StringHash32("const char*")};
+    // 0 picks the hardware thread count. Only snapshot sources (kIsSnapshot) are read in parallel, a source that
+    // calls into the running game always gets one thread.
+    std::uint32_t mThreadCount = 0;
+  };
+  struct ExportOptions : SourceOptions {};
+
+  namespace details {
+    template <typename Source, typename = void>
+    struct IsSnapshot : std::false_type {};
+    template <typename Source>
+    struct IsSnapshot<Source, std::void_t<decltype(Source::kIsSnapshot)>>
+        : std::integral_constant<bool, Source::kIsSnapshot> {};
+
+    // fn(std::size_t idx) for every idx in [0, count), spread over threads only if every source is a snapshot
+    template <typename... Sources, typename Fn>
+    void ForEachIndex(const SourceOptions& options, std::size_t count, Fn&& fn) {
+      std::size_t threadCount = options.mThreadCount ? options.mThreadCount : std::thread::hardware_concurrency();
+      threadCount             = std::min(threadCount, count);
+      if (!(IsSnapshot<Sources>::value && ...) || threadCount <= 1) {
+        for (std::size_t idx = 0; idx < count; idx++) fn(idx);
+        return;
+      }
+
+      WorkerPool::Pool pool(static_cast<std::uint32_t>(threadCount - 1));
+      pool.Run(count, fn);
+    }
+    struct ColumnData {
+      Layout::ColumnEntry        mEntry{};
+      std::vector<std::uint8_t>  mValidity;
+      std::vector<std::uint32_t> mOffsets;
+      std::vector<std::uint8_t>  mValues;
+    };
+    struct ClassData {
+      std::uint32_t              mKey = 0;
+      std::vector<std::uint32_t> mRows;
+      std::vector<ColumnData>    mColumns;
+      std::vector<std::string>   mStrings;  // local dictionary, merged after extraction
+    };
+
+    class Dictionary {
+      std::unordered_map<std::string, std::uint32_t> mIds;
+
+     public:
+      std::vector<std::string> mStrings;
+
+      std::uint32_t Add(std::string_view str) {
+        auto it = mIds.find(std::string(str));
+        if (it != mIds.end()) return it->second;
+
+        auto id = static_cast<std::uint32_t>(mStrings.size());
+        mStrings.emplace_back(str);
+        mIds.emplace(mStrings.back(), id);
+        return id;
+      }
+    };
+
+    template <typename T>
+    void Append(std::vector<std::uint8_t>& out, const T& value) {
+      auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+      out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    // Walk a class through the Attrib::Class-shaped API and build its columns
+    template <typename Source, typename ClassT>
+    ClassData ExtractClass(const Source& source, const ClassT& cls, const ExportOptions& options) {
+      ClassData  data;
+      Dictionary dictionary;
+      data.mKey = cls.GetKey();
+
+      std::vector<decltype(cls.GetCollection(0))> collections;
+      auto numCollections = cls.GetNumCollections();
+      for (auto key = cls.GetFirstCollection(); key && data.mRows.size() < numCollections;
+           key = cls.GetNextCollection(key)) {
+        auto collection = cls.GetCollection(key);
+        if (!collection.IsValid()) continue;
+
+        data.mRows.push_back(key);
+        collections.push_back(collection);
+      }
+
+      auto numDefinitions = cls.GetNumDefinitions();
+      for (auto key = cls.GetFirstDefinition(); key && data.mColumns.size() < numDefinitions;
+           key = cls.GetNextDefinition(key)) {
+        auto* definition = cls.GetDefinition(key);
+        if (!definition) continue;
+
+        const bool isArray  = static_cast<std::uint8_t>(definition->mFlags) & VaultReader::Layout::Definition::Array;
+        const bool isString = std::find(options.mStringTypes.begin(), options.mStringTypes.end(),
+                                        definition->mType) != options.mStringTypes.end();
+
+        auto& column            = data.mColumns.emplace_back();
+        column.mEntry.mKey      = key;
+        column.mEntry.mType     = definition->mType;
+        column.mEntry.mElemSize = isString ? sizeof(std::uint32_t) : definition->mSize;
+        column.mEntry.mKind     = isArray ? (isString ? Layout::ColumnKind::StringArray : Layout::ColumnKind::Array)
+                                          : (isString ? Layout::ColumnKind::String : Layout::ColumnKind::Scalar);
+
+        const std::size_t elemSize = definition->mSize;
+
+        auto appendValue = [&](const auto& collection, std::uint32_t idx) {
+          auto* value = collection.template GetData<std::uint8_t>(key, idx);
+          if (isString) {
+            auto* str = value ? source.ResolveString(collection, value) : nullptr;
+            Append(column.mValues, str ? dictionary.Add(str) : Layout::kNoValue);
+          } else if (value) {
+            column.mValues.insert(column.mValues.end(), value, value + elemSize);
+          } else {
+            column.mValues.resize(column.mValues.size() + elemSize);
+          }
+        };
+
+        if (isArray) column.mOffsets.push_back(0);
+        for (const auto& collection : collections) {
+          auto count = collection.GetCount(key);
+          if (isArray) {
+            for (std::uint32_t i = 0; i < count; i++) appendValue(collection, i);
+            column.mOffsets.push_back(column.mOffsets.back() + count);
+          } else {
+            column.mValidity.push_back(count ? 1 : 0);
+            appendValue(collection, 0);
+          }
+        }
+      }
+
+      data.mStrings = std::move(dictionary.mStrings);
+      return data;
+    }
+
+    class Writer {
+      std::ostream& mStream;
+      std::uint64_t mPosition = 0;
+
+     public:
+      explicit Writer(std::ostream& os) : mStream(os) {}
+
+      std::uint64_t GetPosition() const { return mPosition; }
+      void          Write(const void* data, std::size_t size) {
+        mStream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        mPosition += size;
+      }
+      template <typename T>
+      std::uint64_t WriteVector(const std::vector<T>& values) {
+        Align();
+        auto position = mPosition;
+        if (!values.empty()) Write(values.data(), values.size() * sizeof(T));
+        return position;
+      }
+      void Align() {
+        static const char kZeros[8] = {};
+        if (mPosition % 8) Write(kZeros, 8 - mPosition % 8);
+      }
+      // Overwrite an earlier section in place
+      template <typename T>
+      void Patch(std::uint64_t position, const T& value) {
+        auto current = mStream.tellp();
+        mStream.seekp(static_cast<std::streamoff>(position));
+        mStream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        mStream.seekp(current);
+      }
+    };
+  }  // namespace details
+
+  // Export every class 'source' exposes, extracting classes in parallel when the source is a snapshot.
+  // Source provides 'Class'/'Collection' types shaped like VaultReader's, plus
+  //   void ForEachClass(fn(const Class&)) const
+  //   const char* ResolveString(const Collection&, const std::uint8_t* field) const
+  //   static constexpr bool kIsSnapshot, true if it never calls into the game and so is safe to read from threads
+  // 'os' must be seekable.
+  template <typename Source>
+  bool Export(std::ostream& os, const Source& source, const ExportOptions& options = {}) {
+    std::vector<const typename Source::Class*> classes;
+    source.ForEachClass([&classes](const typename Source::Class& cls) { classes.push_back(&cls); });
+
+    std::vector<details::ClassData> results(classes.size());
+    details::ForEachIndex<Source>(options, classes.size(), [&](std::size_t idx) {
+      results[idx] = details::ExtractClass(source, *classes[idx], options);
+    });
+
+    // Merge the per-class dictionaries and remap string ids
+    details::Dictionary dictionary;
+    for (auto& result : results) {
+      std::vector<std::uint32_t> remap(result.mStrings.size());
+      for (std::size_t i = 0; i < result.mStrings.size(); i++) remap[i] = dictionary.Add(result.mStrings[i]);
+
+      for (auto& column : result.mColumns) {
+        if (column.mEntry.mKind != Layout::ColumnKind::String &&
+            column.mEntry.mKind != Layout::ColumnKind::StringArray)
+          continue;
+
+        auto* ids = reinterpret_cast<std::uint32_t*>(column.mValues.data());
+        for (std::size_t i = 0; i < column.mValues.size() / sizeof(std::uint32_t); i++)
+          if (ids[i] != Layout::kNoValue) ids[i] = remap[ids[i]];
+      }
+    }
+
+    details::Writer writer(os);
+    Layout::Header  header{};
+    header.mMagic      = Layout::kMagic;
+    header.mVersion    = Layout::kVersion;
+    header.mNumClasses = static_cast<std::uint32_t>(results.size());
+    header.mNumStrings = static_cast<std::uint32_t>(dictionary.mStrings.size());
+    writer.Write(&header, sizeof(header));
+
+    std::vector<std::uint32_t> stringOffsets{0};
+    std::vector<char>          stringData;
+    for (const auto& str : dictionary.mStrings) {
+      stringData.insert(stringData.end(), str.begin(), str.end());
+      stringData.push_back('\0');
+      stringOffsets.push_back(static_cast<std::uint32_t>(stringData.size()));
+    }
+    header.mStringOffsets = writer.WriteVector(stringOffsets);
+    header.mStringData    = writer.WriteVector(stringData);
+
+    std::vector<Layout::ClassEntry> classEntries(results.size());
+    header.mClasses = writer.WriteVector(classEntries);
+    for (std::size_t c = 0; c < results.size(); c++) {
+      auto& result      = results[c];
+      auto& entry       = classEntries[c];
+      entry.mKey        = result.mKey;
+      entry.mNumRows    = static_cast<std::uint32_t>(result.mRows.size());
+      entry.mNumColumns = static_cast<std::uint32_t>(result.mColumns.size());
+      entry.mRowKeys    = writer.WriteVector(result.mRows);
+
+      for (auto& column : result.mColumns) {
+        column.mEntry.mValidity   = column.mValidity.empty() ? 0 : writer.WriteVector(column.mValidity);
+        column.mEntry.mOffsets    = column.mOffsets.empty() ? 0 : writer.WriteVector(column.mOffsets);
+        column.mEntry.mValues     = writer.WriteVector(column.mValues);
+        column.mEntry.mValuesSize = column.mValues.size();
+      }
+
+      std::vector<Layout::ColumnEntry> columnEntries;
+      for (const auto& column : result.mColumns) columnEntries.push_back(column.mEntry);
+      entry.mColumns = writer.WriteVector(columnEntries);
+    }
+
+    writer.Patch(0, header);
+    for (std::size_t c = 0; c < classEntries.size(); c++)
+      writer.Patch(header.mClasses + c * sizeof(Layout::ClassEntry), classEntries[c]);
+    return !!os;
+  }
+
+  //        //
+  // Reader //
+  //        //
+
+  class Column {
+    const std::uint8_t*        mBase    = nullptr;
+    const Layout::ColumnEntry* mEntry   = nullptr;
+    std::uint32_t              mNumRows = 0;
+
+    template <typename T>
+    const T* At(std::uint64_t position) const {
+      return position ? reinterpret_cast<const T*>(mBase + position) : nullptr;
+    }
+
+   public:
+    Column() = default;
+    Column(const std::uint8_t* base, const Layout::ColumnEntry* entry, std::uint32_t numRows)
+        : mBase(base), mEntry(entry), mNumRows(numRows) {}
+
+    bool               IsValid() const { return mEntry != nullptr; }
+    std::uint32_t      GetKey() const { return mEntry->mKey; }
+    std::uint32_t      GetType() const { return mEntry->mType; }
+    Layout::ColumnKind GetKind() const { return mEntry->mKind; }
+    std::uint16_t      GetElemSize() const { return mEntry->mElemSize; }
+
+    // Items row 'row' holds; 0 or 1 for scalars
+    std::uint32_t GetCount(std::uint32_t row) const {
+      if (row >= mNumRows) return 0;
+      if (auto* offsets = At<std::uint32_t>(mEntry->mOffsets)) return offsets[row + 1] - offsets[row];
+      return At<std::uint8_t>(mEntry->mValidity)[row];
+    }
+    // Raw item, nullptr if missing
+    const std::uint8_t* GetRaw(std::uint32_t row, std::uint32_t idx = 0) const {
+      if (idx >= GetCount(row)) return nullptr;
+
+      auto* offsets = At<std::uint32_t>(mEntry->mOffsets);
+      auto  item    = offsets ? offsets[row] + idx : row;
+      return At<std::uint8_t>(mEntry->mValues) + std::uint64_t(item) * mEntry->mElemSize;
+    }
+    template <typename T>
+    const T* Get(std::uint32_t row, std::uint32_t idx = 0) const {
+      return reinterpret_cast<const T*>(GetRaw(row, idx));
+    }
+    // Contiguous values of a scalar column, for scans
+    template <typename T>
+    const T* GetValues() const {
+      return At<T>(mEntry->mValues);
+    }
+  };
+
+  class Table {
+    const std::uint8_t*       mBase  = nullptr;
+    const Layout::ClassEntry* mEntry = nullptr;
+
+   public:
+    Table() = default;
+    Table(const std::uint8_t* base, const Layout::ClassEntry* entry) : mBase(base), mEntry(entry) {}
+
+    bool                 IsValid() const { return mEntry != nullptr; }
+    std::uint32_t        GetKey() const { return mEntry->mKey; }
+    std::uint32_t        GetNumRows() const { return mEntry->mNumRows; }
+    const std::uint32_t* GetRowKeys() const { return reinterpret_cast<const std::uint32_t*>(mBase + mEntry->mRowKeys); }
+
+    Column GetColumn(std::uint32_t key) const {
+      auto* columns = reinterpret_cast<const Layout::ColumnEntry*>(mBase + mEntry->mColumns);
+      for (std::uint32_t i = 0; i < mEntry->mNumColumns; i++)
+        if (columns[i].mKey == key) return Column(mBase, &columns[i], mEntry->mNumRows);
+      return {};
+    }
+  };
+
+  // Memory mapped export
+  class File {
+    VaultReader::MappedFile mFile;
+    const Layout::Header*   mHeader         = nullptr;
+    std::uint64_t           mStringDataSize = 0;
+
+    template <typename T>
+    const T* At(std::uint64_t position) const {
+      return reinterpret_cast<const T*>(mFile.GetData() + position);
+    }
+    // 'count' items of 'size' bytes at 'position' fit the file and are aligned, without forming a pointer outside it
+    bool Contains(std::uint64_t position, std::uint64_t count, std::uint64_t size, std::uint64_t alignment) const {
+      if (position > mFile.GetSize() || (reinterpret_cast<std::uintptr_t>(mFile.GetData()) + position) % alignment)
+        return false;
+      return !count || count <= (mFile.GetSize() - position) / size;
+    }
+    template <typename T>
+    bool Contains(std::uint64_t position, std::uint64_t count) const {
+      return Contains(position, count, sizeof(T), alignof(T));
+    }
+
+    // Every section a Column reads fits the file; array offsets must not go backwards
+    bool IsValid(const Layout::ColumnEntry& column, std::uint32_t numRows) const {
+      std::uint64_t numItems = numRows;
+      switch (column.mKind) {
+        case Layout::ColumnKind::Scalar:
+        case Layout::ColumnKind::String:
+          if (column.mOffsets || (numRows && !column.mValidity)) return false;
+          if (!Contains<std::uint8_t>(column.mValidity, numRows)) return false;
+          break;
+        case Layout::ColumnKind::Array:
+        case Layout::ColumnKind::StringArray: {
+          if (!column.mOffsets || !Contains<std::uint32_t>(column.mOffsets, std::uint64_t(numRows) + 1)) return false;
+
+          auto* offsets = At<std::uint32_t>(column.mOffsets);
+          for (std::uint32_t row = 0; row < numRows; row++)
+            if (offsets[row + 1] < offsets[row]) return false;
+          numItems = offsets[numRows];
+          break;
+        }
+        default: return false;
+      }
+      const bool isString =
+          column.mKind == Layout::ColumnKind::String || column.mKind == Layout::ColumnKind::StringArray;
+      if (isString && column.mElemSize != sizeof(std::uint32_t)) return false;
+      if (numItems * column.mElemSize > column.mValuesSize) return false;
+      return Contains(column.mValues, column.mValuesSize, 1, 8);
+    }
+    bool IsValid(const Layout::ClassEntry& cls) const {
+      if (!Contains<std::uint32_t>(cls.mRowKeys, cls.mNumRows)) return false;
+      if (!Contains<Layout::ColumnEntry>(cls.mColumns, cls.mNumColumns)) return false;
+
+      auto* columns = At<Layout::ColumnEntry>(cls.mColumns);
+      for (std::uint32_t i = 0; i < cls.mNumColumns; i++)
+        if (!IsValid(columns[i], cls.mNumRows)) return false;
+      return true;
+    }
+
+   public:
+    // Rejects files whose sections don't fit, e.g. a truncated export
+    bool Open(const char* path) {
+      mHeader = nullptr;
+      if (!mFile.Open(path) || mFile.GetSize() < sizeof(Layout::Header)) return false;
+
+      auto* header = At<Layout::Header>(0);
+      if (header->mMagic != Layout::kMagic || header->mVersion != Layout::kVersion) return false;
+
+      if (!Contains<std::uint32_t>(header->mStringOffsets, std::uint64_t(header->mNumStrings) + 1)) return false;
+      mStringDataSize = At<std::uint32_t>(header->mStringOffsets)[header->mNumStrings];
+      if (!Contains<char>(header->mStringData, mStringDataSize)) return false;
+      if (!Contains<Layout::ClassEntry>(header->mClasses, header->mNumClasses)) return false;
+
+      auto* classes = At<Layout::ClassEntry>(header->mClasses);
+      for (std::uint32_t i = 0; i < header->mNumClasses; i++)
+        if (!IsValid(classes[i])) return false;
+
+      mHeader = header;
+      return true;
+    }
+
+    std::uint32_t GetNumClasses() const { return mHeader ? mHeader->mNumClasses : 0; }
+    // Missing table past GetNumClasses()
+    Table GetClassAt(std::uint32_t idx) const {
+      if (idx >= GetNumClasses()) return {};
+
+      auto* classes = At<Layout::ClassEntry>(mHeader->mClasses);
+      return Table(mFile.GetData(), &classes[idx]);
+    }
+    Table GetClass(std::uint32_t key) const {
+      for (std::uint32_t i = 0; i < GetNumClasses(); i++)
+        if (GetClassAt(i).GetKey() == key) return GetClassAt(i);
+      return {};
+    }
+
+    // nullptr for unknown ids or strings that start or run past the string data
+    const char* GetString(std::uint32_t id) const {
+      if (!mHeader || id >= mHeader->mNumStrings) return nullptr;
+
+      const std::uint64_t offset = At<std::uint32_t>(mHeader->mStringOffsets)[id];
+      if (offset >= mStringDataSize) return nullptr;
+
+      auto* str = At<char>(mHeader->mStringData + offset);
+      return std::memchr(str, '\0', mStringDataSize - offset) ? str : nullptr;
+    }
+  };
+
+  //                  //
+  // VaultReader glue //
+  //                  //
+
+  // Export source over an offline VaultReader::Database
+  class VaultSource {
+    const VaultReader::Database& mDatabase;
+
+   public:
+    using Class      = VaultReader::Class;
+    using Collection = VaultReader::Collection;
+
+    static constexpr bool kIsSnapshot = true;
+
+    explicit VaultSource(const VaultReader::Database& database) : mDatabase(database) {}
+
+    template <typename Fn>
+    void ForEachClass(Fn&& fn) const {
+      mDatabase.ForEachClass(fn);
+    }
+    const char* ResolveString(const Collection& collection, const std::uint8_t* field) const {
+      return collection.ResolveString(field);
+    }
+  };
+}  // namespace AttribColumnar
@@ -0,0 +1,227 @@
+// clang-format off
+//
+//    AttribDiff: A header-only library to compare two Attrib databases, live or offline. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <algorithm>      // sort, unique, find
+#include <cstdint>        // integer types
+#include <cstring>        // strlen
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+#include <OpenSpeed/Core/AttribColumnar/AttribColumnar.hpp>  // AttribColumnar::SourceOptions, details::ForEachIndex
+
+namespace AttribDiff {
+  enum class ChangeKind : std::uint8_t { Added, Removed, Changed };
+
+  // A whole class if mCollection is 0, a whole collection if mField is 0, otherwise one field
+  struct Change {
+    std::uint32_t mClass;
+    std::uint32_t mCollection;
+    std::uint32_t mField;
+    ChangeKind    mKind;
+  };
+
+  // String fields are compared by content
+  struct DiffOptions : AttribColumnar::SourceOptions {};
+
+  namespace details {
+    // 64-bit FNV-1a
+    struct Hasher {
+      std::uint64_t mValue = 0xCBF29CE484222325;
+
+      void Add(const void* data, std::size_t size) {
+        auto* bytes = static_cast<const std::uint8_t*>(data);
+        for (std::size_t i = 0; i < size; i++) mValue = (mValue ^ bytes[i]) * 0x100000001B3;
+      }
+      template <typename T>
+      void Add(const T& value) {
+        Add(&value, sizeof(T));
+      }
+    };
+
+    struct FieldInfo {
+      std::uint32_t mKey;
+      std::uint16_t mSize;
+      bool          mIsString;
+    };
+
+    // Definitions of a class, sorted by key
+    template <typename ClassT>
+    std::vector<FieldInfo> GetFields(const ClassT* cls, const DiffOptions& options) {
+      std::vector<FieldInfo> fields;
+      if (!cls) return fields;
+
+      auto numDefinitions = cls->GetNumDefinitions();
+      for (auto key = cls->GetFirstDefinition(); key && fields.size() < numDefinitions;
+           key = cls->GetNextDefinition(key)) {
+        auto* definition = cls->GetDefinition(key);
+        if (!definition) continue;
+
+        const bool isString = std::find(options.mStringTypes.begin(), options.mStringTypes.end(),
+                                        definition->mType) != options.mStringTypes.end();
+        fields.push_back({key, definition->mSize, isString});
+      }
+      std::sort(fields.begin(), fields.end(), [](const auto& a, const auto& b) { return a.mKey < b.mKey; });
+      return fields;
+    }
+
+    // Collection keys of a class, sorted
+    template <typename ClassT>
+    std::vector<std::uint32_t> GetCollectionKeys(const ClassT* cls) {
+      std::vector<std::uint32_t> keys;
+      if (!cls) return keys;
+
+      auto numCollections = cls->GetNumCollections();
+      for (auto key = cls->GetFirstCollection(); key && keys.size() < numCollections;
+           key = cls->GetNextCollection(key))
+        keys.push_back(key);
+      std::sort(keys.begin(), keys.end());
+      return keys;
+    }
+
+    // Hash of one field's count and items, 0 if the collection doesn't have it
+    template <typename Source, typename CollectionT>
+    std::uint64_t HashField(const Source& source, const CollectionT& collection, const FieldInfo& field) {
+      auto count = collection.GetCount(field.mKey);
+      if (!count) return 0;
+
+      Hasher hasher;
+      hasher.Add(count);
+      for (std::uint32_t idx = 0; idx < count; idx++) {
+        auto* value = collection.template GetData<std::uint8_t>(field.mKey, idx);
+        if (!value) {
+          hasher.Add(std::uint8_t(0));
+        } else if (field.mIsString) {
+          auto* str = source.ResolveString(collection, value);
+          if (str) hasher.Add(str, std::strlen(str) + 1);
+        } else {
+          hasher.Add(value, field.mSize);
+        }
+      }
+      return hasher.mValue | 1;  // never 0
+    }
+
+    template <typename Source, typename CollectionT>
+    std::uint64_t HashCollection(const Source& source, const CollectionT& collection,
+                                 const std::vector<FieldInfo>& fields) {
+      Hasher hasher;
+      for (const auto& field : fields) {
+        if (auto hash = HashField(source, collection, field)) {
+          hasher.Add(field.mKey);
+          hasher.Add(hash);
+        }
+      }
+      return hasher.mValue;
+    }
+
+    template <typename SourceA, typename SourceB>
+    std::vector<Change> DiffClass(const SourceA& sourceA, const typename SourceA::Class* a, const SourceB& sourceB,
+                                  const typename SourceB::Class* b, std::uint32_t classKey,
+                                  const DiffOptions& options) {
+      std::vector<Change> changes;
+      if (!a || !b) {
+        changes.push_back({classKey, 0, 0, a ? ChangeKind::Removed : ChangeKind::Added});
+        return changes;
+      }
+
+      // Compare over both sides' definitions; a field only one side defines is added or removed
+      auto fieldsA = GetFields(a, options);
+      auto fieldsB = GetFields(b, options);
+
+      const auto keysA = GetCollectionKeys(a);
+      const auto keysB = GetCollectionKeys(b);
+      std::size_t ia = 0, ib = 0;
+      while (ia < keysA.size() || ib < keysB.size()) {
+        if (ib == keysB.size() || (ia < keysA.size() && keysA[ia] < keysB[ib])) {
+          changes.push_back({classKey, keysA[ia++], 0, ChangeKind::Removed});
+          continue;
+        }
+        if (ia == keysA.size() || keysB[ib] < keysA[ia]) {
+          changes.push_back({classKey, keysB[ib++], 0, ChangeKind::Added});
+          continue;
+        }
+
+        const auto key         = keysA[ia++];
+        auto       collectionA = a->GetCollection(key);
+        auto       collectionB = b->GetCollection(keysB[ib++]);
+        if (!collectionA.IsValid() || !collectionB.IsValid()) continue;
+
+        // Equal payloads are the common case, only mismatches go field by field
+        if (HashCollection(sourceA, collectionA, fieldsA) == HashCollection(sourceB, collectionB, fieldsB)) continue;
+
+        std::size_t fa = 0, fb = 0;
+        while (fa < fieldsA.size() || fb < fieldsB.size()) {
+          std::uint64_t hashA = 0, hashB = 0;
+          std::uint32_t field = 0;
+          if (fb == fieldsB.size() || (fa < fieldsA.size() && fieldsA[fa].mKey < fieldsB[fb].mKey)) {
+            field = fieldsA[fa].mKey;
+            hashA = HashField(sourceA, collectionA, fieldsA[fa++]);
+          } else if (fa == fieldsA.size() || fieldsB[fb].mKey < fieldsA[fa].mKey) {
+            field = fieldsB[fb].mKey;
+            hashB = HashField(sourceB, collectionB, fieldsB[fb++]);
+          } else {
+            field = fieldsA[fa].mKey;
+            hashA = HashField(sourceA, collectionA, fieldsA[fa++]);
+            hashB = HashField(sourceB, collectionB, fieldsB[fb++]);
+          }
+
+          if (hashA == hashB) continue;
+          changes.push_back({classKey, key, field,
+                             !hashA ? ChangeKind::Added : !hashB ? ChangeKind::Removed : ChangeKind::Changed});
+        }
+      }
+      return changes;
+    }
+  }  // namespace details
+
+  // Changes from 'sourceA' to 'sourceB', sorted by class, collection and field; classes are compared in parallel
+  // when both sources are snapshots.
+  // Sources are the same as AttribColumnar::Export's and may differ, e.g. a vault file against the running game.
+  // Usage: auto changes = AttribDiff::Diff(AttribColumnar::VaultSource(before), AttribColumnar::VaultSource(after));
+  template <typename SourceA, typename SourceB>
+  std::vector<Change> Diff(const SourceA& sourceA, const SourceB& sourceB, const DiffOptions& options = {}) {
+    std::unordered_map<std::uint32_t, const typename SourceA::Class*> classesA;
+    std::unordered_map<std::uint32_t, const typename SourceB::Class*> classesB;
+    std::vector<std::uint32_t>                                        classKeys;
+    sourceA.ForEachClass([&](const typename SourceA::Class& cls) {
+      classesA[cls.GetKey()] = &cls;
+      classKeys.push_back(cls.GetKey());
+    });
+    sourceB.ForEachClass([&](const typename SourceB::Class& cls) {
+      classesB[cls.GetKey()] = &cls;
+      classKeys.push_back(cls.GetKey());
+    });
+    std::sort(classKeys.begin(), classKeys.end());
+    classKeys.erase(std::unique(classKeys.begin(), classKeys.end()), classKeys.end());
+
+    std::vector<std::vector<Change>> results(classKeys.size());
+    AttribColumnar::details::ForEachIndex<SourceA, SourceB>(options, classKeys.size(), [&](std::size_t idx) {
+      auto key     = classKeys[idx];
+      auto itA     = classesA.find(key);
+      auto itB     = classesB.find(key);
+      results[idx] = details::DiffClass(sourceA, itA != classesA.end() ? itA->second : nullptr, sourceB,
+                                        itB != classesB.end() ? itB->second : nullptr, key, options);
+    });
+
+    std::vector<Change> changes;
+    for (auto& result : results) changes.insert(changes.end(), result.begin(), result.end());
+    return changes;
+  }
+}  // namespace AttribDiff
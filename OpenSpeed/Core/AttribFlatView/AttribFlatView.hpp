@@ -0,0 +1,135 @@
+// clang-format off
+//
+//    AttribFlatView: A header-only library to flatten Attrib collections and their parents into single tables. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <cstddef>  // offsetof
+#include <cstdint>  // integer types
+#include <new>      // placement new
+
+#include <OpenSpeed/Core/ArenaAllocator/ArenaAllocator.hpp>  // ArenaAllocator::Arena
+#include <OpenSpeed/Core/AttribReader/AttribReader.hpp>      // AttribReader::FindNode, Layout
+
+namespace AttribFlatView {
+  using MemorySnapshot::Address;
+
+  // One field resolved through the parent chain
+  struct Entry {
+    std::uint32_t mKey;
+    Address       mData;      // item 0, or the first array element
+    std::uint16_t mCount;     // 0 if no collection in the chain has the field
+    std::uint16_t mStride;    // array element size, 0 for scalars
+    bool          mIndirect;  // array of pointers, mData holds their addresses
+  };
+
+  // Flattened collection; an open-addressing table at most half full, key 0 marks an empty slot
+  class View {
+    const Entry*  mEntries;
+    std::uint32_t mMask;
+    Address       mCollection;
+
+    static std::uint32_t Mix(std::uint32_t key) { return (key ^ (key >> 16)) * 0x45D9F3B; }
+
+    template <typename Source, typename Class>
+    friend const View* Build(ArenaAllocator::Arena&, const Source&, Address, Class&);
+
+    View(const Entry* entries, std::uint32_t mask, Address collection)
+        : mEntries(entries), mMask(mask), mCollection(collection) {}
+
+   public:
+    Address GetCollection() const { return mCollection; }
+
+    // nullptr for keys the class doesn't define
+    const Entry* Find(std::uint32_t key) const {
+      if (!key) return nullptr;
+
+      for (std::uint32_t idx = Mix(key);; idx++) {
+        const auto& entry = mEntries[idx & mMask];
+        if (entry.mKey == key) return &entry;
+        if (!entry.mKey) return nullptr;
+      }
+    }
+    std::uint32_t GetCount(std::uint32_t key) const {
+      auto* entry = Find(key);
+      return entry ? entry->mCount : 0;
+    }
+    // Same result as AttribReader::GetDataAddress, without walking parents
+    template <typename Source>
+    Address GetDataAddress(const Source& source, std::uint32_t key, std::uint32_t idx = 0) const {
+      auto* entry = Find(key);
+      if (!entry || idx >= entry->mCount) return 0;
+      if (!entry->mIndirect) return entry->mData + idx * entry->mStride;
+
+      Address item = 0;
+      return MemorySnapshot::ReadValue(source, entry->mData + idx * sizeof(Address), item) ? item : 0;
+    }
+  };
+
+  namespace details {
+    template <typename Source>
+    Entry Resolve(const Source& source, Address collection, std::uint32_t key) {
+      using namespace AttribReader;
+
+      Entry        entry{key, 0, 0, 0, false};
+      Layout::Node node;
+      Address      nodeAddress = 0;
+      if (!FindNode(source, collection, key, node, &nodeAddress)) return entry;
+
+      if (node.mFlags & IsArray) {
+        Layout::Array array;
+        if (!MemorySnapshot::ReadValue(source, node.mPtr, array)) return entry;
+
+        entry.mData     = node.mPtr + sizeof(Layout::Array) + array.GetPad();
+        entry.mCount    = array.mCount;
+        entry.mStride   = array.mSize;
+        entry.mIndirect = !array.mSize;
+        return entry;
+      }
+
+      entry.mData  = node.mFlags & IsByValue ? nodeAddress + offsetof(Layout::Node, mPtr) : node.mPtr;
+      entry.mCount = entry.mData ? 1 : 0;
+      return entry;
+    }
+  }  // namespace details
+
+  // Resolve every field 'cls' defines for 'collection' into 'arena', the view lives until the arena is reset
+  // Works with anything shaped like Attrib::Class, e.g. the game's or VaultReader::Class
+  // Usage: auto* view = AttribFlatView::Build(arena, MemorySnapshot::LiveMemory{}, collection, *cls);
+  template <typename Source, typename Class>
+  const View* Build(ArenaAllocator::Arena& arena, const Source& source, Address collection, Class& cls) {
+    const std::uint32_t numDefinitions = cls.GetNumDefinitions();
+
+    std::uint32_t size = 8;
+    while (size < numDefinitions * 2) size <<= 1;
+
+    auto* entries = arena.Allocate<Entry>(size);
+    auto* memory  = arena.Allocate(sizeof(View), alignof(View));
+
+    for (std::uint32_t i = 0; i < size; i++) entries[i] = Entry{0, 0, 0, 0, false};
+
+    const std::uint32_t mask = size - 1;
+    std::uint32_t       key  = cls.GetFirstDefinition();
+    for (std::uint32_t i = 0; key && i < numDefinitions; i++, key = cls.GetNextDefinition(key)) {
+      std::uint32_t idx = View::Mix(key);
+      while (entries[idx & mask].mKey && entries[idx & mask].mKey != key) idx++;
+      entries[idx & mask] = details::Resolve(source, collection, key);
+    }
+    return new (memory) View(entries, mask, collection);
+  }
+}  // namespace AttribFlatView
@@ -0,0 +1,160 @@
+// clang-format off
+//
+//    AttribReader: A header-only native reader for Attrib collection tables, live or from snapshots. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <cstddef>  // offsetof
+#include <cstdint>  // integer types
+
+#include <OpenSpeed/Core/MemorySnapshot/MemorySnapshot.hpp>  // MemorySnapshot::Address, ReadValue
+
+namespace AttribReader {
+  using MemorySnapshot::Address;
+
+  // 32-bit layouts of the games' Attrib types, pointers as addresses (same in MW05 and Carbon)
+  namespace Layout {
+    struct Node {
+      std::uint32_t mKey;
+      Address       mPtr;  // or the value itself when stored by value
+      std::uint16_t mTypeIndex;
+      std::uint8_t  mMax;
+      std::uint8_t  mFlags;
+    };
+    struct HashMap {
+      Address       mTable;
+      std::uint32_t mTableSize;
+      std::uint32_t mNumEntries;
+      std::uint16_t mWorstCollision;
+      std::uint16_t mKeyShift;
+    };
+    struct Collection {
+      HashMap       mTable;
+      Address       mParent;
+      Address       mClass;
+      Address       mLayout;
+      std::uint32_t mRefCount;
+      std::uint32_t mKey;
+      Address       mSource;
+      Address       mNamePtr;
+    };
+    // Header in front of array attribute data
+    struct Array {
+      std::uint16_t mAlloc;
+      std::uint16_t mCount;
+      std::uint16_t mSize;  // element size, 0 if elements are pointers
+      std::uint16_t mEncodedTypePad;
+
+      std::uint32_t GetPad() const { return mEncodedTypePad >> 12; }
+      std::uint16_t GetTypeIndex() const { return mEncodedTypePad & 0x0FFF; }
+    };
+
+    static_assert(sizeof(Node) == 0xC, "Layout::Node size mismatch.");
+    static_assert(sizeof(HashMap) == 0x10, "Layout::HashMap size mismatch.");
+    static_assert(sizeof(Collection) == 0x2C, "Layout::Collection size mismatch.");
+    static_assert(sizeof(Array) == 0x8, "Layout::Array size mismatch.");
+  }  // namespace Layout
+
+  enum NodeFlags : std::uint8_t {
+    RequiresRelease = 1 << 0,
+    IsArray         = 1 << 1,
+    IsInherited     = 1 << 2,
+    IsAccessor      = 1 << 3,
+    IsLaidOut       = 1 << 4,
+    IsByValue       = 1 << 5,
+    IsLocatable     = 1 << 6,
+  };
+
+  // Guards against cycles in damaged snapshots
+  static constexpr std::uint32_t kMaxParentDepth = 32;
+
+  // Probe a collection's own table; at most mWorstCollision + 1 slots are checked
+  template <typename Source>
+  bool FindNodeInTable(const Source& source, const Layout::HashMap& table, std::uint32_t key, Layout::Node& out,
+                       Address* outAddress = nullptr) {
+    if (!table.mTable || !table.mTableSize || !table.mNumEntries) return false;
+
+    std::uint32_t idx = (key >> table.mKeyShift) % table.mTableSize;
+    for (std::uint32_t tries = 0; tries <= table.mWorstCollision; tries++) {
+      Address address = table.mTable + idx * sizeof(Layout::Node);
+      if (!MemorySnapshot::ReadValue(source, address, out)) return false;
+      if (out.mKey == key) {
+        if (outAddress) *outAddress = address;
+        return true;
+      }
+      if (++idx == table.mTableSize) idx = 0;
+    }
+    return false;
+  }
+
+  // Find the node for 'key' in 'collection' or its parents, reporting the collection that owns it
+  template <typename Source>
+  bool FindNode(const Source& source, Address collection, std::uint32_t key, Layout::Node& out,
+                Address* outAddress = nullptr, Address* outOwner = nullptr) {
+    Layout::Collection data;
+    for (std::uint32_t depth = 0; collection && depth < kMaxParentDepth; depth++) {
+      if (!MemorySnapshot::ReadValue(source, collection, data)) return false;
+      if (FindNodeInTable(source, data.mTable, key, out, outAddress)) {
+        if (outOwner) *outOwner = collection;
+        return true;
+      }
+      collection = data.mParent;
+    }
+    return false;
+  }
+
+  // Number of items attribute 'key' holds, 0 if missing
+  template <typename Source>
+  std::uint32_t GetCount(const Source& source, Address collection, std::uint32_t key) {
+    Layout::Node node;
+    if (!FindNode(source, collection, key, node)) return 0;
+    if (!(node.mFlags & IsArray)) return 1;
+
+    Layout::Array array;
+    return MemorySnapshot::ReadValue(source, node.mPtr, array) ? array.mCount : 0;
+  }
+
+  // Address of item 'idx' of attribute 'key', 0 if missing; mirrors Collection::GetData
+  template <typename Source>
+  Address GetDataAddress(const Source& source, Address collection, std::uint32_t key, std::uint32_t idx = 0) {
+    Layout::Node node;
+    Address      nodeAddress = 0;
+    if (!FindNode(source, collection, key, node, &nodeAddress)) return 0;
+
+    if (node.mFlags & IsArray) {
+      Layout::Array array;
+      if (!MemorySnapshot::ReadValue(source, node.mPtr, array) || idx >= array.mCount) return 0;
+
+      Address base = node.mPtr + sizeof(Layout::Array) + array.GetPad();
+      if (array.mSize) return base + idx * array.mSize;
+
+      Address item = 0;
+      return MemorySnapshot::ReadValue(source, base + idx * sizeof(Address), item) ? item : 0;
+    }
+    if (idx) return 0;
+    if (node.mFlags & IsByValue) return nodeAddress + offsetof(Layout::Node, mPtr);
+    return node.mPtr;
+  }
+
+  // Usage: float mass; if (AttribReader::GetData(source, collection, "MASS"_key, mass)) ...
+  template <typename T, typename Source>
+  bool GetData(const Source& source, Address collection, std::uint32_t key, T& out, std::uint32_t idx = 0) {
+    Address address = GetDataAddress(source, collection, key, idx);
+    return address && MemorySnapshot::ReadValue(source, address, out);
+  }
+}  // namespace AttribReader
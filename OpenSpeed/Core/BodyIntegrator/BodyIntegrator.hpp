@@ -0,0 +1,312 @@
+// clang-format off
+//
+//    BodyIntegrator: Header-only SSE rigid body state integrator for dead reckoning and replay checks. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <algorithm>    // min, max
+#include <cmath>        // sqrt, asin
+#include <cstddef>      // size_t
+#include <cstdint>      // integer types
+#include <xmmintrin.h>  // SSE intrinsics
+
+#include <OpenSpeed/Core/MemorySnapshot/MemorySnapshot.hpp>  // MemorySnapshot::Address, ReadValue
+
+namespace BodyIntegrator {
+  // Semi-implicit Euler, the same order the games step their bodies in:
+  //   v += force * oom * dt,           position    += v * dt
+  //   w += I_world^-1 * torque * dt,   orientation += 0.5 * dt * [w, 0] * orientation, then renormalized
+  // Velocities, force and torque are in world space; the inertia is the principal (body space) one, a zero
+  // component locks that axis. Force and torque are held constant across steps unless cleared.
+
+  // One body; vectors are [x, y, z], the orientation is a unit quaternion [x, y, z, w]
+  struct State {
+    float mPosition[3];
+    float mOrientation[4];
+    float mLinearVelocity[3];
+    float mAngularVelocity[3];
+    float mInertia[3];
+    float mOOM;
+    float mForce[3];
+    float mTorque[3];
+  };
+
+  // 32-bit layout of the games' RigidBody::Volatile, to load states from recorded snapshots
+  namespace Layout {
+    // Same storage order as UMath::Vector3/Vector4
+    struct Vector3 {
+      float y, z, x;
+    };
+    struct Vector4 {
+      float y, z, x, w;
+    };
+
+    struct Volatile {
+      Vector4       orientation;
+      Vector3       position;
+      std::uint32_t statusPrev;
+      Vector3       linearVelocity;
+      float         mass;
+      Vector3       angularVelocity;
+      float         oom;
+      Vector3       InertiaTensor;
+      std::uint32_t status;
+      Vector3       force;
+      std::int8_t   leversInContact;
+      std::int8_t   mode;
+      std::int8_t   index;
+      std::int8_t   __unused2;
+      Vector3       torque;
+      float         radius;
+      Vector4       bodyMatrix[4];
+    };
+    static_assert(sizeof(Volatile) == 0xB0, "Layout::Volatile size mismatch.");
+  }  // namespace Layout
+
+  // Anything shaped like RigidBody::Volatile (named x/y/z/w fields), in-process or Layout::Volatile
+  template <typename Volatile>
+  State ToState(const Volatile& from) {
+    return {{from.position.x, from.position.y, from.position.z},
+            {from.orientation.x, from.orientation.y, from.orientation.z, from.orientation.w},
+            {from.linearVelocity.x, from.linearVelocity.y, from.linearVelocity.z},
+            {from.angularVelocity.x, from.angularVelocity.y, from.angularVelocity.z},
+            {from.InertiaTensor.x, from.InertiaTensor.y, from.InertiaTensor.z},
+            from.oom,
+            {from.force.x, from.force.y, from.force.z},
+            {from.torque.x, from.torque.y, from.torque.z}};
+  }
+  // Usage: BodyIntegrator::State state; if (BodyIntegrator::ReadState(snapshot, volatileAddress, state)) ...
+  template <typename Source>
+  bool ReadState(const Source& source, MemorySnapshot::Address volatileAddress, State& out) {
+    Layout::Volatile from;
+    if (!MemorySnapshot::ReadValue(source, volatileAddress, from)) return false;
+
+    out = ToState(from);
+    return true;
+  }
+
+  namespace details {
+    inline float Inverse(float v) { return v > 0.0f ? 1.0f / v : 0.0f; }
+  }  // namespace details
+
+  // Scalar reference step, Batch::Step() must match it to float rounding
+  inline void Step(State& state, float dt) {
+    const float oom_dt = state.mOOM * dt;
+    for (std::size_t k = 0; k < 3; k++) {
+      state.mLinearVelocity[k] += state.mForce[k] * oom_dt;
+      state.mPosition[k] += state.mLinearVelocity[k] * dt;
+    }
+
+    const float qx = state.mOrientation[0], qy = state.mOrientation[1], qz = state.mOrientation[2],
+                qw = state.mOrientation[3];
+
+    // Local axes in world space, as CollisionEx builds them
+    const float axes[3][3] = {
+        {1.0f - 2.0f * (qy * qy + qz * qz), 2.0f * (qx * qy + qw * qz), 2.0f * (qx * qz - qw * qy)},
+        {2.0f * (qx * qy - qw * qz), 1.0f - 2.0f * (qx * qx + qz * qz), 2.0f * (qy * qz + qw * qx)},
+        {2.0f * (qx * qz + qw * qy), 2.0f * (qy * qz - qw * qx), 1.0f - 2.0f * (qx * qx + qy * qy)}};
+    for (std::size_t i = 0; i < 3; i++) {
+      const float local = (axes[i][0] * state.mTorque[0] + axes[i][1] * state.mTorque[1] +
+                           axes[i][2] * state.mTorque[2]) *
+                          details::Inverse(state.mInertia[i]) * dt;
+      for (std::size_t k = 0; k < 3; k++) state.mAngularVelocity[k] += axes[i][k] * local;
+    }
+
+    const float h = 0.5f * dt, wx = state.mAngularVelocity[0], wy = state.mAngularVelocity[1],
+                wz = state.mAngularVelocity[2];
+    float q[4] = {qx + h * (wx * qw + wy * qz - wz * qy), qy + h * (wy * qw - wx * qz + wz * qx),
+                  qz + h * (wz * qw + wx * qy - wy * qx), qw - h * (wx * qx + wy * qy + wz * qz)};
+    const float length = std::sqrt((q[0] * q[0] + q[1] * q[1]) + (q[2] * q[2] + q[3] * q[3]));
+    for (std::size_t k = 0; k < 4; k++) state.mOrientation[k] = q[k] / length;
+  }
+
+  // Up to N bodies as structure-of-arrays, stepped four at a time. Unused lanes of the last group hold a resting
+  // body so they never produce NaNs.
+  // Usage: BodyIntegrator::Batch<64> batch; batch.Add(state); batch.Advance(1.0f / 60.0f, 3); batch.Get(0, state);
+  template <std::size_t N>
+  class Batch {
+    static constexpr std::size_t kLanes = 4;
+    static constexpr std::size_t kSize  = (N + kLanes - 1) & ~(kLanes - 1);
+
+    // [position xyz, orientation xyzw, linear velocity xyz, angular velocity xyz, inverse inertia xyz, oom,
+    //  force xyz, torque xyz]
+    enum Column : std::size_t {
+      kPositionX,
+      kOrientationX     = kPositionX + 3,
+      kLinearVelocityX  = kOrientationX + 4,
+      kAngularVelocityX = kLinearVelocityX + 3,
+      kInvInertiaX      = kAngularVelocityX + 3,
+      kOOM              = kInvInertiaX + 3,
+      kForceX,
+      kTorqueX     = kForceX + 3,
+      kColumnCount = kTorqueX + 3
+    };
+
+    alignas(16) float mData[kColumnCount][kSize];
+    std::size_t mCount = 0;
+
+    void Set(std::size_t idx, const State& state) {
+      for (std::size_t k = 0; k < 3; k++) {
+        mData[kPositionX + k][idx]        = state.mPosition[k];
+        mData[kLinearVelocityX + k][idx]  = state.mLinearVelocity[k];
+        mData[kAngularVelocityX + k][idx] = state.mAngularVelocity[k];
+        mData[kInvInertiaX + k][idx]      = details::Inverse(state.mInertia[k]);
+        mData[kForceX + k][idx]           = state.mForce[k];
+        mData[kTorqueX + k][idx]          = state.mTorque[k];
+      }
+      for (std::size_t k = 0; k < 4; k++) mData[kOrientationX + k][idx] = state.mOrientation[k];
+      mData[kOOM][idx] = state.mOOM;
+    }
+
+    void StepGroup(std::size_t base, __m128 dt) {
+      auto load  = [&](std::size_t column) { return _mm_load_ps(&mData[column][base]); };
+      auto store = [&](std::size_t column, __m128 v) { _mm_store_ps(&mData[column][base], v); };
+      auto madd  = [](__m128 a, __m128 b, __m128 c) { return _mm_add_ps(a, _mm_mul_ps(b, c)); };
+
+      const __m128 oom_dt = _mm_mul_ps(load(kOOM), dt);
+      for (std::size_t k = 0; k < 3; k++) {
+        const __m128 v = madd(load(kLinearVelocityX + k), load(kForceX + k), oom_dt);
+        store(kLinearVelocityX + k, v);
+        store(kPositionX + k, madd(load(kPositionX + k), v, dt));
+      }
+
+      const __m128 qx = load(kOrientationX), qy = load(kOrientationX + 1), qz = load(kOrientationX + 2),
+                   qw = load(kOrientationX + 3);
+      const __m128 one = _mm_set1_ps(1.0f), two = _mm_set1_ps(2.0f);
+
+      __m128 axes[3][3];
+      axes[0][0] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qy, qy), _mm_mul_ps(qz, qz))));
+      axes[0][1] = _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qx, qy), _mm_mul_ps(qw, qz)));
+      axes[0][2] = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, qz), _mm_mul_ps(qw, qy)));
+      axes[1][0] = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, qy), _mm_mul_ps(qw, qz)));
+      axes[1][1] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qz, qz))));
+      axes[1][2] = _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qy, qz), _mm_mul_ps(qw, qx)));
+      axes[2][0] = _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qx, qz), _mm_mul_ps(qw, qy)));
+      axes[2][1] = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qy, qz), _mm_mul_ps(qw, qx)));
+      axes[2][2] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(qx, qx), _mm_mul_ps(qy, qy))));
+
+      const __m128 tx = load(kTorqueX), ty = load(kTorqueX + 1), tz = load(kTorqueX + 2);
+      __m128       w[3] = {load(kAngularVelocityX), load(kAngularVelocityX + 1), load(kAngularVelocityX + 2)};
+      for (std::size_t i = 0; i < 3; i++) {
+        __m128 local = _mm_add_ps(_mm_add_ps(_mm_mul_ps(axes[i][0], tx), _mm_mul_ps(axes[i][1], ty)),
+                                  _mm_mul_ps(axes[i][2], tz));
+        local        = _mm_mul_ps(_mm_mul_ps(local, load(kInvInertiaX + i)), dt);
+        for (std::size_t k = 0; k < 3; k++) w[k] = madd(w[k], axes[i][k], local);
+      }
+      for (std::size_t k = 0; k < 3; k++) store(kAngularVelocityX + k, w[k]);
+
+      const __m128 h = _mm_mul_ps(_mm_set1_ps(0.5f), dt);
+      __m128       q[4];
+      q[0] = madd(qx, h, _mm_sub_ps(_mm_add_ps(_mm_mul_ps(w[0], qw), _mm_mul_ps(w[1], qz)), _mm_mul_ps(w[2], qy)));
+      q[1] = madd(qy, h, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(w[1], qw), _mm_mul_ps(w[0], qz)), _mm_mul_ps(w[2], qx)));
+      q[2] = madd(qz, h, _mm_sub_ps(_mm_add_ps(_mm_mul_ps(w[2], qw), _mm_mul_ps(w[0], qy)), _mm_mul_ps(w[1], qx)));
+      q[3] = _mm_sub_ps(
+          qw, _mm_mul_ps(h, _mm_add_ps(_mm_add_ps(_mm_mul_ps(w[0], qx), _mm_mul_ps(w[1], qy)), _mm_mul_ps(w[2], qz))));
+
+      const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(q[0], q[0]), _mm_mul_ps(q[1], q[1])),
+                                                   _mm_add_ps(_mm_mul_ps(q[2], q[2]), _mm_mul_ps(q[3], q[3]))));
+      for (std::size_t k = 0; k < 4; k++) store(kOrientationX + k, _mm_div_ps(q[k], length));
+    }
+
+   public:
+    static constexpr std::size_t kCapacity = N;
+
+    Batch() { Clear(); }
+
+    void Clear() {
+      mCount = 0;
+      for (auto& column : mData)
+        for (auto& value : column) value = 0.0f;
+      for (auto& value : mData[kOrientationX + 3]) value = 1.0f;
+    }
+    std::size_t GetCount() const { return mCount; }
+
+    // Returns the body's index, or -1 if the batch is full
+    std::int32_t Add(const State& state) {
+      if (mCount == N) return -1;
+
+      Set(mCount, state);
+      return static_cast<std::int32_t>(mCount++);
+    }
+    // Unchecked, 'idx' must be below GetCount(). The inertia comes back inverted twice, so locked axes stay 0.
+    void Get(std::size_t idx, State& out) const {
+      for (std::size_t k = 0; k < 3; k++) {
+        out.mPosition[k]        = mData[kPositionX + k][idx];
+        out.mLinearVelocity[k]  = mData[kLinearVelocityX + k][idx];
+        out.mAngularVelocity[k] = mData[kAngularVelocityX + k][idx];
+        out.mInertia[k]         = details::Inverse(mData[kInvInertiaX + k][idx]);
+        out.mForce[k]           = mData[kForceX + k][idx];
+        out.mTorque[k]          = mData[kTorqueX + k][idx];
+      }
+      for (std::size_t k = 0; k < 4; k++) out.mOrientation[k] = mData[kOrientationX + k][idx];
+      out.mOOM = mData[kOOM][idx];
+    }
+    // Position only, for overlays that interpolate between ticks
+    void GetPosition(std::size_t idx, float (&out)[3]) const {
+      for (std::size_t k = 0; k < 3; k++) out[k] = mData[kPositionX + k][idx];
+    }
+
+    void Step(float dt) {
+      const __m128 dt4 = _mm_set1_ps(dt);
+      for (std::size_t base = 0; base < mCount; base += kLanes) StepGroup(base, dt4);
+    }
+    // 'steps' steps of 'dt' each
+    void Advance(float dt, std::size_t steps) {
+      for (std::size_t i = 0; i < steps; i++) Step(dt);
+    }
+
+    // Stop extrapolating the last applied force and torque, the game clears them after every tick
+    void ClearForces() {
+      for (std::size_t k = 0; k < 3; k++) {
+        for (auto& value : mData[kForceX + k]) value = 0.0f;
+        for (auto& value : mData[kTorqueX + k]) value = 0.0f;
+      }
+    }
+  };
+
+  // How far a prediction is from a recorded state
+  struct Error {
+    float mPosition;        // distance
+    float mOrientation;     // angle in radians
+    float mLinearVelocity;  // magnitude of the difference
+    float mAngularVelocity;
+  };
+  inline Error Compare(const State& predicted, const State& recorded) {
+    auto distance = [](const float (&a)[3], const float (&b)[3]) {
+      const float dx = a[0] - b[0], dy = a[1] - b[1], dz = a[2] - b[2];
+      return std::sqrt(dx * dx + dy * dy + dz * dz);
+    };
+
+    // Angle from the chord between the quaternions (q and -q are the same rotation), acos(dot) is too coarse
+    // near zero to tell float rounding from a real difference
+    float dot = 0.0f;
+    for (std::size_t k = 0; k < 4; k++) dot += predicted.mOrientation[k] * recorded.mOrientation[k];
+
+    const float sign  = dot < 0.0f ? -1.0f : 1.0f;
+    float       chord = 0.0f;
+    for (std::size_t k = 0; k < 4; k++) {
+      const float d = predicted.mOrientation[k] - sign * recorded.mOrientation[k];
+      chord += d * d;
+    }
+
+    return {distance(predicted.mPosition, recorded.mPosition),
+            4.0f * std::asin(std::min(std::sqrt(chord) * 0.5f, 1.0f)),
+            distance(predicted.mLinearVelocity, recorded.mLinearVelocity),
+            distance(predicted.mAngularVelocity, recorded.mAngularVelocity)};
+  }
+}  // namespace BodyIntegrator
@@ -0,0 +1,287 @@
+// clang-format off
+//
+//    EASTLView: Header-only read-only views of the games' EASTL vector, list and map, live or from snapshots. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <algorithm>    // min
+#include <cstddef>      // size_t
+#include <cstdint>      // integer types
+#include <functional>   // less
+#include <type_traits>  // is_trivially_copyable_v
+
+#include <OpenSpeed/Core/EASTL/EASTL/list.h>                  // eastl::list
+#include <OpenSpeed/Core/EASTL/EASTL/map.h>                   // eastl::map
+#include <OpenSpeed/Core/EASTL/EASTL/vector.h>                // eastl::vector
+#include <OpenSpeed/Core/InstanceRange/InstanceRange.hpp>    // InstanceRange::Invoke
+#include <OpenSpeed/Core/MemorySnapshot/MemorySnapshot.hpp>  // MemorySnapshot::Address, ReadValue
+
+namespace EASTLView {
+  using MemorySnapshot::Address;
+
+  // 32-bit layouts of the vendored EASTL containers with the default allocator (which keeps a name pointer)
+  namespace Layout {
+    struct Allocator {
+      Address mpName;
+    };
+    struct Vector {
+      Address   mpBegin;
+      Address   mpEnd;
+      Address   mpCapacity;
+      Allocator mAllocator;
+    };
+    // The value follows the links
+    struct ListNode {
+      Address mpNext;
+      Address mpPrev;
+    };
+    struct List {
+      ListNode      mNode;  // sentinel, its address is end()
+      Allocator     mAllocator;
+      std::uint32_t mSize;
+    };
+    // The value follows the links, aligned to its own alignment
+    struct TreeNode {
+      Address      mpNodeRight;
+      Address      mpNodeLeft;
+      Address      mpNodeParent;
+      std::uint8_t mColor;
+    };
+    struct Tree {
+      TreeNode      mAnchor;  // left is begin(), right is the last node, parent is the root
+      std::uint32_t mnSize;
+      Allocator     mAllocator;
+    };
+
+    static_assert(sizeof(Vector) == 0x10, "Layout::Vector size mismatch.");
+    static_assert(sizeof(List) == 0x10, "Layout::List size mismatch.");
+    static_assert(sizeof(TreeNode) == 0x10, "Layout::TreeNode size mismatch.");
+    static_assert(sizeof(Tree) == 0x18, "Layout::Tree size mismatch.");
+
+    // Keep the layouts honest against the vendored headers when building for the games
+    static_assert(sizeof(void*) != 4 || sizeof(eastl::vector<int>) == sizeof(Vector), "Vector layout mismatch.");
+    static_assert(sizeof(void*) != 4 || sizeof(eastl::list<int>) == sizeof(List), "List layout mismatch.");
+    static_assert(sizeof(void*) != 4 || sizeof(eastl::map<int, int>) == sizeof(Tree), "Tree layout mismatch.");
+
+    constexpr Address GetValueOffset(std::size_t nodeSize, std::size_t valueAlign) {
+      return static_cast<Address>((nodeSize + valueAlign - 1) / valueAlign * valueAlign);
+    }
+  }  // namespace Layout
+
+  // Upper bound for any walk, a corrupt container can't make a view run away
+  static constexpr std::size_t kMaxSize = 0x10000;
+
+  // Address of an in-process container, to view it through MemorySnapshot::LiveMemory
+  inline Address AddressOf(const void* container) {
+    return static_cast<Address>(reinterpret_cast<std::uintptr_t>(container));
+  }
+
+  // Callbacks returning bool stop the walk on false, like InstanceRange::ForEach
+
+  // eastl::vector<T>, 'T' being its 32-bit element type (MemorySnapshot::Address for pointers)
+  // Usage: EASTLView::Vector<Address> v; if (v.Open(source, address)) v.ForEach(source, [](Address p) { ... });
+  template <typename T>
+  class Vector {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
+
+    Address     mBegin = 0;
+    std::size_t mSize  = 0;
+
+   public:
+    template <typename Source>
+    bool Open(const Source& source, Address vectorAddress) {
+      Layout::Vector vector;
+      if (!MemorySnapshot::ReadValue(source, vectorAddress, vector)) return false;
+      if (vector.mpEnd < vector.mpBegin || vector.mpCapacity < vector.mpEnd) return false;
+
+      mBegin = vector.mpBegin;
+      mSize  = std::min<std::size_t>((vector.mpEnd - vector.mpBegin) / sizeof(T), kMaxSize);
+      return true;
+    }
+
+    std::size_t GetSize() const { return mSize; }
+    Address     GetAddress(std::size_t idx) const { return mBegin + static_cast<Address>(idx * sizeof(T)); }
+
+    // Fails when out of range or unreadable
+    template <typename Source>
+    bool Read(const Source& source, std::size_t idx, T& out) const {
+      return idx < mSize && MemorySnapshot::ReadValue(source, GetAddress(idx), out);
+    }
+    // Elements [first, first + count) in one read into 'out'
+    template <typename Source>
+    bool Read(const Source& source, std::size_t first, std::size_t count, T* out) const {
+      if (first > mSize || count > mSize - first) return false;
+      return !count || source.Read(GetAddress(first), out, count * sizeof(T));
+    }
+
+    template <typename Source, typename Fn>
+    bool ForEach(const Source& source, Fn&& fn) const {
+      T item;
+      for (std::size_t i = 0; i < mSize; i++) {
+        if (!MemorySnapshot::ReadValue(source, GetAddress(i), item)) return false;
+        if (!InstanceRange::Invoke(fn, item)) break;
+      }
+      return true;
+    }
+  };
+
+  // eastl::list<T>, walked from the sentinel until it comes back or mSize/kMaxSize nodes were seen
+  template <typename T>
+  class List {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
+
+    static constexpr Address kValueOffset = Layout::GetValueOffset(sizeof(Layout::ListNode), alignof(T));
+
+    Address     mSentinel = 0;
+    Address     mFirst    = 0;
+    std::size_t mSize     = 0;
+
+   public:
+    template <typename Source>
+    bool Open(const Source& source, Address listAddress) {
+      Layout::List list;
+      if (!MemorySnapshot::ReadValue(source, listAddress, list)) return false;
+
+      mSentinel = listAddress;
+      mFirst    = list.mNode.mpNext;
+      mSize     = std::min<std::size_t>(list.mSize, kMaxSize);
+      return true;
+    }
+
+    std::size_t GetSize() const { return mSize; }
+
+    // Returns false if a link couldn't be read
+    template <typename Source, typename Fn>
+    bool ForEach(const Source& source, Fn&& fn) const {
+      Address node = mFirst;
+      T       item;
+      for (std::size_t i = 0; i < mSize && node && node != mSentinel; i++) {
+        if (!MemorySnapshot::ReadValue(source, node + kValueOffset, item)) return false;
+        if (!InstanceRange::Invoke(fn, item)) break;
+
+        Layout::ListNode links;
+        if (!MemorySnapshot::ReadValue(source, node, links)) return false;
+        node = links.mpNext;
+      }
+      return true;
+    }
+  };
+
+  // Same layout as eastl::pair<const K, V>
+  template <typename K, typename V>
+  struct Pair {
+    K first;
+    V second;
+  };
+
+  // eastl::map<K, V> (or set/multimap, given the right 'Value'), walked in order without recursion or allocation
+  // Usage: EASTLView::Map<std::uint32_t, Address> m; if (m.Open(source, address)) m.Find(source, key, value);
+  template <typename K, typename V, typename Value = Pair<K, V>, typename Compare = std::less<K>>
+  class Map {
+    static_assert(std::is_trivially_copyable_v<Value>, "Value must be trivially copyable.");
+
+    static constexpr Address kValueOffset = Layout::GetValueOffset(sizeof(Layout::TreeNode), alignof(Value));
+
+    Address     mAnchor = 0;
+    Address     mRoot   = 0;
+    Address     mFirst  = 0;
+    std::size_t mSize   = 0;
+
+    template <typename Source>
+    bool ReadNode(const Source& source, Address node, Layout::TreeNode& out) const {
+      return MemorySnapshot::ReadValue(source, node, out);
+    }
+
+    // In-order successor through the parent links, 0 if it can't be read
+    template <typename Source>
+    Address GetNext(const Source& source, Address node, const Layout::TreeNode& links) const {
+      Layout::TreeNode current;
+      if (links.mpNodeRight) {
+        node = links.mpNodeRight;
+        for (std::size_t depth = 0; depth < 64; depth++) {
+          if (!ReadNode(source, node, current)) return 0;
+          if (!current.mpNodeLeft) return node;
+          node = current.mpNodeLeft;
+        }
+        return 0;
+      }
+
+      Address parent = links.mpNodeParent;
+      for (std::size_t depth = 0; depth < 64 && parent != mAnchor; depth++) {
+        if (!ReadNode(source, parent, current)) return 0;
+        if (current.mpNodeRight != node) return parent;
+
+        node   = parent;
+        parent = current.mpNodeParent;
+      }
+      return mAnchor;
+    }
+
+   public:
+    template <typename Source>
+    bool Open(const Source& source, Address mapAddress) {
+      Layout::Tree tree;
+      if (!MemorySnapshot::ReadValue(source, mapAddress, tree)) return false;
+
+      mAnchor = mapAddress;
+      mSize   = std::min<std::size_t>(tree.mnSize, kMaxSize);
+      mRoot   = mSize ? tree.mAnchor.mpNodeParent : 0;
+      mFirst  = mSize ? tree.mAnchor.mpNodeLeft : mapAddress;
+      return true;
+    }
+
+    std::size_t GetSize() const { return mSize; }
+
+    // Visits the values in key order; returns false if a node couldn't be read
+    template <typename Source, typename Fn>
+    bool ForEach(const Source& source, Fn&& fn) const {
+      Address          node = mFirst;
+      Layout::TreeNode links;
+      Value            value;
+      for (std::size_t i = 0; i < mSize && node != mAnchor; i++) {
+        if (!node || !ReadNode(source, node, links)) return false;
+        if (!MemorySnapshot::ReadValue(source, node + kValueOffset, value)) return false;
+        if (!InstanceRange::Invoke(fn, value)) break;
+
+        node = GetNext(source, node, links);
+      }
+      return true;
+    }
+
+    // Binary search from the root, O(log n) node reads
+    template <typename Source>
+    bool Find(const Source& source, const K& key, Value& out) const {
+      Address          node = mRoot;
+      Layout::TreeNode links;
+      Compare          less;
+      for (std::size_t depth = 0; depth < 64 && node; depth++) {
+        if (!ReadNode(source, node, links)) return false;
+        if (!MemorySnapshot::ReadValue(source, node + kValueOffset, out)) return false;
+
+        const K& nodeKey = reinterpret_cast<const K&>(out);
+        if (less(key, nodeKey))
+          node = links.mpNodeLeft;
+        else if (less(nodeKey, key))
+          node = links.mpNodeRight;
+        else
+          return true;
+      }
+      return false;
+    }
+  };
+}  // namespace EASTLView
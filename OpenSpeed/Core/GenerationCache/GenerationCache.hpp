@@ -0,0 +1,137 @@
+// clang-format off
+//
+//    GenerationCache: A header-only open-addressing cache with generation invalidation and lock-free reads. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <atomic>       // atomic
+#include <cstdint>      // integer types
+#include <memory>       // unique_ptr
+#include <mutex>        // mutex, scoped_lock
+#include <type_traits>  // is_pointer
+
+namespace GenerationCache {
+  // Fixed-size open-addressing map from 64-bit keys to pointers.
+  // Entries remember the generation they were written in; bumping the generation drops all of them at once.
+  // Reads never lock (per-slot sequence counters), writes are serialized.
+  template <typename T>
+  class Table {
+    static_assert(std::is_pointer_v<T>, "T must be a pointer type.");
+
+    struct Slot {
+      std::atomic<std::uint32_t>  mSequence{0};  // odd while being written
+      std::atomic<std::uint32_t>  mGeneration{0};
+      std::atomic<std::uint64_t>  mKey{0};
+      std::atomic<std::uintptr_t> mValue{0};
+    };
+
+    std::unique_ptr<Slot[]>    mSlots;
+    std::uint32_t              mMask;
+    std::uint32_t              mMaxProbes;
+    std::atomic<std::uint32_t> mGeneration{1};
+    std::mutex                 mWriteMutex;
+
+    static std::uint32_t Hash(std::uint64_t key) {
+      key ^= key >> 33;
+      key *= 0xFF51AFD7ED558CCDull;
+      key ^= key >> 33;
+      return static_cast<std::uint32_t>(key);
+    }
+
+   public:
+    // 'capacity' is rounded up to a power of two
+    explicit Table(std::uint32_t capacity = 4096, std::uint32_t maxProbes = 16) : mMaxProbes(maxProbes) {
+      std::uint32_t size = 1;
+      while (size < capacity) size <<= 1;
+      mSlots = std::make_unique<Slot[]>(size);
+      mMask  = size - 1;
+    }
+
+    // Drop every entry in O(1)
+    void Invalidate() { mGeneration.fetch_add(1, std::memory_order_acq_rel); }
+    std::uint32_t GetGeneration() const { return mGeneration.load(std::memory_order_acquire); }
+
+    // Lock-free; safe from any thread
+    bool Find(std::uint64_t key, T& out) const {
+      const auto generation = GetGeneration();
+
+      auto idx = Hash(key);
+      for (std::uint32_t probe = 0; probe < mMaxProbes; probe++, idx++) {
+        const auto& slot = mSlots[idx & mMask];
+
+        std::uint32_t  sequence, slotGeneration;
+        std::uint64_t  slotKey;
+        std::uintptr_t value;
+        do {
+          sequence       = slot.mSequence.load(std::memory_order_acquire);
+          slotGeneration = slot.mGeneration.load(std::memory_order_relaxed);
+          slotKey        = slot.mKey.load(std::memory_order_relaxed);
+          value          = slot.mValue.load(std::memory_order_relaxed);
+          std::atomic_thread_fence(std::memory_order_acquire);
+        } while ((sequence & 1) || sequence != slot.mSequence.load(std::memory_order_relaxed));
+
+        // Stale slots count as empty, so nothing past them was written this generation
+        if (slotGeneration != generation) return false;
+        if (slotKey == key) {
+          out = reinterpret_cast<T>(value);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Returns false if the probe window is full, the value just isn't cached then. A nullptr value is cached too, Find()
+    // then returns true with a nullptr 'out', e.g. for keys known to have no value.
+    bool Insert(std::uint64_t key, T value) { return Insert(key, value, GetGeneration()); }
+    // Insert a value looked up during 'generation', skipped if it was invalidated since
+    bool Insert(std::uint64_t key, T value, std::uint32_t generation) {
+      std::scoped_lock _lock(mWriteMutex);
+      if (generation != GetGeneration()) return false;
+
+      auto idx = Hash(key);
+      for (std::uint32_t probe = 0; probe < mMaxProbes; probe++, idx++) {
+        auto& slot = mSlots[idx & mMask];
+        if (slot.mGeneration.load(std::memory_order_relaxed) == generation &&
+            slot.mKey.load(std::memory_order_relaxed) != key)
+          continue;
+
+        auto sequence = slot.mSequence.load(std::memory_order_relaxed);
+        slot.mSequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.mKey.store(key, std::memory_order_relaxed);
+        slot.mValue.store(reinterpret_cast<std::uintptr_t>(value), std::memory_order_relaxed);
+        slot.mGeneration.store(generation, std::memory_order_relaxed);
+        slot.mSequence.store(sequence + 2, std::memory_order_release);
+        return true;
+      }
+      return false;
+    }
+
+    // Usage: auto* p = table.GetOrAdd(key, [&] { return SlowLookup(); });
+    template <typename Fn>
+    T GetOrAdd(std::uint64_t key, Fn&& fn) {
+      T value = nullptr;
+      if (Find(key, value)) return value;
+
+      const auto generation = GetGeneration();
+      value                 = fn();
+      if (value) Insert(key, value, generation);
+      return value;
+    }
+  };
+}  // namespace GenerationCache
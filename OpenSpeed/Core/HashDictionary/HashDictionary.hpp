@@ -0,0 +1,398 @@
+// clang-format off
+//
+//    HashDictionary: A header-only, memory mappable reverse dictionary for the games' string hashes. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <algorithm>    // sort, unique, lower_bound, min, max
+#include <atomic>       // atomic
+#include <cstdint>      // integer types
+#include <cstring>      // memcpy, memchr
+#include <ostream>      // ostream
+#include <string_view>  // string_view
+#include <thread>       // thread
+#include <vector>       // vector
+
+#include <OpenSpeed/Core/Hashing/Hashing.hpp>          // Hashing::BStringHash, StringHash32
+#include <OpenSpeed/Core/VaultReader/VaultReader.hpp>  // VaultReader::MappedFile
+
+namespace HashDictionary {
+  // Attrib keys are stringhash32, so StringHash32 covers them too. UCrc32 isn't here, the games' CRC hasn't been
+  // matched against a hash they computed yet.
+  enum class Algorithm : std::uint32_t { BStringHash, StringHash32, Count };
+
+  static std::uint32_t Hash(Algorithm algorithm, std::string_view str) {
+    switch (algorithm) {
+      case Algorithm::BStringHash: return Hashing::BStringHash(str.data(), str.size());
+      case Algorithm::StringHash32: return Hashing::StringHash32(str.data(), str.size());
+      default: return 0;
+    }
+  }
+
+  // File layout: Header, string table, then per algorithm a TableEntry with its minimal perfect hash.
+  // Every section is 8-byte aligned, positions are absolute file offsets; little-endian.
+  namespace Layout {
+    static constexpr std::uint32_t kMagic   = 0x4448534F;  // OSHD
+    static constexpr std::uint32_t kVersion = 2;
+
+    struct Header {
+      std::uint32_t mMagic;
+      std::uint32_t mVersion;
+      std::uint32_t mNumStrings;
+      std::uint32_t mNumTables;
+      std::uint64_t mStringOffsets;  // u32[mNumStrings + 1], into mStringData
+      std::uint64_t mStringData;
+      std::uint64_t mTables;  // TableEntry[mNumTables]
+    };
+    // Minimal perfect hash, BBHash style: a key sits at the rank of its first level's set bit.
+    // Keys colliding on every level are kept in a sorted fallback list.
+    struct TableEntry {
+      Algorithm     mAlgorithm;
+      std::uint32_t mNumKeys;
+      std::uint32_t mNumLevels;
+      std::uint32_t mNumFallback;
+      std::uint64_t mLevels;    // Level[mNumLevels]
+      std::uint64_t mWords;     // u64 bits of all levels back to back
+      std::uint64_t mRanks;     // u32 set bits before every kRankWords words
+      std::uint64_t mValues;    // Value[mNumKeys - mNumFallback], by rank
+      std::uint64_t mFallback;  // Value[mNumFallback], sorted by hash
+    };
+    struct Level {
+      std::uint64_t mFirstBit;
+      std::uint64_t mNumBits;
+    };
+    struct Value {
+      std::uint32_t mHash;  // checked on lookup, unknown hashes land on arbitrary slots
+      std::uint32_t mString;
+    };
+
+    static constexpr std::uint32_t kRankWords = 8;
+
+    static_assert(sizeof(Header) == 0x28, "Layout::Header size mismatch.");
+    static_assert(sizeof(TableEntry) == 0x38, "Layout::TableEntry size mismatch.");
+    static_assert(sizeof(Level) == 0x10, "Layout::Level size mismatch.");
+    static_assert(sizeof(Value) == 0x8, "Layout::Value size mismatch.");
+  }  // namespace Layout
+
+  namespace details {
+    static constexpr std::uint32_t kMaxLevels = 32;
+
+    static std::uint64_t LevelHash(std::uint32_t key, std::uint32_t level) {
+      std::uint64_t x = ((static_cast<std::uint64_t>(level) << 32) | key) + 0x9E3779B97F4A7C15;
+      x               = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+      x               = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+      return x ^ (x >> 31);
+    }
+    static std::uint32_t PopCount(std::uint64_t x) {
+      x = x - ((x >> 1) & 0x5555555555555555);
+      x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+      x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0F;
+      return static_cast<std::uint32_t>((x * 0x0101010101010101) >> 56);
+    }
+
+    // Keys at bit 'bit' of the level bits sit at the number of set bits before it
+    static std::uint64_t Rank(const std::uint64_t* words, const std::uint32_t* ranks, std::uint64_t bit) {
+      const auto word = bit / 64;
+
+      std::uint64_t rank = ranks[word / Layout::kRankWords];
+      for (auto w = word - word % Layout::kRankWords; w < word; w++) rank += PopCount(words[w]);
+      return rank + PopCount(words[word] & ((std::uint64_t(1) << (bit % 64)) - 1));
+    }
+
+    // Run fn(begin, end) over [0, count) split across threads
+    template <typename Fn>
+    void ParallelFor(std::size_t count, std::uint32_t threadCount, Fn&& fn) {
+      threadCount = std::max(1u, std::min<std::uint32_t>(threadCount, static_cast<std::uint32_t>(count / 4096 + 1)));
+
+      const std::size_t        chunk = (count + threadCount - 1) / threadCount;
+      std::vector<std::thread> threads;
+      for (std::uint32_t i = 1; i < threadCount; i++)
+        threads.emplace_back([&, i] { fn(std::min(count, i * chunk), std::min(count, (i + 1) * chunk)); });
+      fn(0, std::min(count, chunk));
+      for (auto& thread : threads) thread.join();
+    }
+
+    struct TableData {
+      Layout::TableEntry         mEntry{};
+      std::vector<Layout::Level> mLevels;
+      std::vector<std::uint64_t> mWords;
+      std::vector<std::uint32_t> mRanks;
+      std::vector<Layout::Value> mValues;
+      std::vector<Layout::Value> mFallback;
+    };
+
+    // 'values' must be unique by hash
+    static TableData BuildTable(Algorithm algorithm, const std::vector<Layout::Value>& values, float gamma,
+                                std::uint32_t threadCount) {
+      TableData table;
+      table.mEntry.mAlgorithm = algorithm;
+      table.mEntry.mNumKeys   = static_cast<std::uint32_t>(values.size());
+
+      std::vector<std::uint32_t> keys(values.size()), next;
+      for (std::size_t i = 0; i < values.size(); i++) keys[i] = values[i].mHash;
+
+      for (std::uint32_t level = 0; level < kMaxLevels && !keys.empty(); level++) {
+        const std::uint64_t numWords = std::max<std::uint64_t>(1, (std::uint64_t(gamma * keys.size()) + 63) / 64);
+        const std::uint64_t numBits  = numWords * 64;
+
+        std::vector<std::atomic<std::uint64_t>> seen(numWords), collided(numWords);
+        ParallelFor(keys.size(), threadCount, [&](std::size_t begin, std::size_t end) {
+          for (std::size_t i = begin; i < end; i++) {
+            auto bit  = LevelHash(keys[i], level) % numBits;
+            auto mask = std::uint64_t(1) << (bit % 64);
+            if (seen[bit / 64].fetch_or(mask, std::memory_order_relaxed) & mask)
+              collided[bit / 64].fetch_or(mask, std::memory_order_relaxed);
+          }
+        });
+
+        table.mLevels.push_back({table.mWords.size() * 64, numBits});
+        for (std::uint64_t w = 0; w < numWords; w++) table.mWords.push_back(seen[w].load() & ~collided[w].load());
+
+        next.clear();
+        for (auto key : keys) {
+          auto bit = LevelHash(key, level) % numBits;
+          if (collided[bit / 64].load(std::memory_order_relaxed) & (std::uint64_t(1) << (bit % 64)))
+            next.push_back(key);
+        }
+        keys.swap(next);
+      }
+
+      std::uint32_t rank = 0;
+      for (std::size_t w = 0; w < table.mWords.size(); w++) {
+        if (w % Layout::kRankWords == 0) table.mRanks.push_back(rank);
+        rank += PopCount(table.mWords[w]);
+      }
+      table.mEntry.mNumLevels   = static_cast<std::uint32_t>(table.mLevels.size());
+      table.mEntry.mNumFallback = static_cast<std::uint32_t>(keys.size());
+      return table;
+    }
+  }  // namespace details
+
+  // Memory mapped dictionary; lookups are a few hashes and one rank, no search
+  class Dictionary {
+    VaultReader::MappedFile   mFile;
+    const std::uint8_t*       mData           = nullptr;
+    std::size_t               mSize           = 0;
+    const Layout::Header*     mHeader         = nullptr;
+    std::uint64_t             mStringDataSize = 0;
+    const Layout::TableEntry* mTables[static_cast<std::size_t>(Algorithm::Count)] = {};
+
+    template <typename T>
+    const T* At(std::uint64_t position) const {
+      return reinterpret_cast<const T*>(mData + position);
+    }
+    // 'count' T at 'position' fit the image and are aligned, without forming a pointer outside it
+    template <typename T>
+    bool Contains(std::uint64_t position, std::uint64_t count) const {
+      if (position > mSize || (reinterpret_cast<std::uintptr_t>(mData) + position) % alignof(T)) return false;
+      return count <= (mSize - position) / sizeof(T);
+    }
+
+    // Every section the lookups read fits the image
+    bool IsValid(const Layout::TableEntry& table) const {
+      if (table.mNumFallback > table.mNumKeys || table.mNumLevels > details::kMaxLevels) return false;
+      if (!Contains<Layout::Level>(table.mLevels, table.mNumLevels)) return false;
+
+      std::uint64_t numWords = 0;
+      auto*         levels   = At<Layout::Level>(table.mLevels);
+      for (std::uint32_t level = 0; level < table.mNumLevels; level++) {
+        const auto& info = levels[level];
+        if (!info.mNumBits || info.mNumBits > mSize * 8 || info.mFirstBit > mSize * 8) return false;
+        numWords = std::max(numWords, (info.mFirstBit + info.mNumBits + 63) / 64);
+      }
+      return Contains<std::uint64_t>(table.mWords, numWords) &&
+             Contains<std::uint32_t>(table.mRanks, (numWords + Layout::kRankWords - 1) / Layout::kRankWords) &&
+             Contains<Layout::Value>(table.mValues, table.mNumKeys - table.mNumFallback) &&
+             Contains<Layout::Value>(table.mFallback, table.mNumFallback);
+    }
+
+    const Layout::Value* FindValue(const Layout::TableEntry& table, std::uint32_t hash) const {
+      auto* levels = At<Layout::Level>(table.mLevels);
+      auto* words  = At<std::uint64_t>(table.mWords);
+      for (std::uint32_t level = 0; level < table.mNumLevels; level++) {
+        auto bit = levels[level].mFirstBit + details::LevelHash(hash, level) % levels[level].mNumBits;
+        if (!(words[bit / 64] & (std::uint64_t(1) << (bit % 64)))) continue;
+
+        // Corrupt rank counts can point past the values
+        const auto rank = details::Rank(words, At<std::uint32_t>(table.mRanks), bit);
+        return rank < table.mNumKeys - table.mNumFallback ? At<Layout::Value>(table.mValues) + rank : nullptr;
+      }
+
+      auto* fallback = At<Layout::Value>(table.mFallback);
+      auto* end      = fallback + table.mNumFallback;
+      auto* it       = std::lower_bound(fallback, end, hash,
+                                        [](const Layout::Value& v, std::uint32_t h) { return v.mHash < h; });
+      return it != end ? it : nullptr;
+    }
+
+   public:
+    bool Open(const char* path) {
+      mHeader = nullptr;
+      return mFile.Open(path) && Attach(mFile.GetData(), mFile.GetSize());
+    }
+    // Use an image already in memory, e.g. a resource; it must outlive the dictionary
+    // Rejects images whose sections don't fit 'size'
+    bool Attach(const std::uint8_t* data, std::size_t size) {
+      mHeader = nullptr;
+      if (!data || size < sizeof(Layout::Header)) return false;
+
+      auto* header = reinterpret_cast<const Layout::Header*>(data);
+      if (header->mMagic != Layout::kMagic || header->mVersion != Layout::kVersion) return false;
+
+      mData = data;
+      mSize = size;
+      if (!Contains<std::uint32_t>(header->mStringOffsets, std::uint64_t(header->mNumStrings) + 1)) return false;
+      mStringDataSize = At<std::uint32_t>(header->mStringOffsets)[header->mNumStrings];
+      if (!Contains<char>(header->mStringData, mStringDataSize)) return false;
+      if (!Contains<Layout::TableEntry>(header->mTables, header->mNumTables)) return false;
+
+      std::fill(std::begin(mTables), std::end(mTables), nullptr);
+      for (std::uint32_t i = 0; i < header->mNumTables; i++) {
+        auto* table = At<Layout::TableEntry>(header->mTables) + i;
+        if (!IsValid(*table)) return false;
+        if (table->mAlgorithm < Algorithm::Count) mTables[static_cast<std::size_t>(table->mAlgorithm)] = table;
+      }
+      mHeader = header;
+      return true;
+    }
+
+    std::uint32_t GetNumStrings() const { return mHeader ? mHeader->mNumStrings : 0; }
+    const char*   GetString(std::uint32_t id) const {
+      if (!mHeader || id >= mHeader->mNumStrings) return nullptr;
+
+      // Null if the string starts or runs past the string data
+      const std::uint64_t offset = At<std::uint32_t>(mHeader->mStringOffsets)[id];
+      if (offset >= mStringDataSize) return nullptr;
+
+      auto* str = At<char>(mHeader->mStringData + offset);
+      return std::memchr(str, '\0', mStringDataSize - offset) ? str : nullptr;
+    }
+
+    // Usage: if (auto* name = dictionary.Find(HashDictionary::Algorithm::StringHash32, collection->mKey)) ...
+    const char* Find(Algorithm algorithm, std::uint32_t hash) const {
+      if (!mHeader || algorithm >= Algorithm::Count) return nullptr;
+
+      auto* table = mTables[static_cast<std::size_t>(algorithm)];
+      if (!table || !table->mNumKeys) return nullptr;
+
+      auto* value = FindValue(*table, hash);
+      return value && value->mHash == hash ? GetString(value->mString) : nullptr;
+    }
+  };
+
+  struct BuildOptions {
+    // Bits per key on each level, more is faster to build and query but larger
+    float mGamma = 2.0f;
+    // 0 picks the hardware thread count
+    std::uint32_t mThreadCount = 0;
+  };
+
+  // Hash every string with every algorithm and write the dictionary; on collisions the earliest string wins.
+  // Duplicate strings are stored once.
+  inline bool Build(std::ostream& os, std::vector<std::string_view> strings, const BuildOptions& options = {}) {
+    const std::uint32_t threadCount =
+        options.mThreadCount ? options.mThreadCount : std::max(1u, std::thread::hardware_concurrency());
+
+    std::sort(strings.begin(), strings.end());
+    strings.erase(std::unique(strings.begin(), strings.end()), strings.end());
+
+    // Hash the corpus once per algorithm, in parallel
+    constexpr auto kNumTables = static_cast<std::size_t>(Algorithm::Count);
+    std::vector<Layout::Value> values[kNumTables];
+    for (auto& v : values) v.resize(strings.size());
+    details::ParallelFor(strings.size(), threadCount, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++)
+        for (std::size_t t = 0; t < kNumTables; t++)
+          values[t][i] = {Hash(static_cast<Algorithm>(t), strings[i]), static_cast<std::uint32_t>(i)};
+    });
+
+    std::vector<details::TableData> tables;
+    for (std::size_t t = 0; t < kNumTables; t++) {
+      auto& v = values[t];
+      std::stable_sort(v.begin(), v.end(), [](const auto& a, const auto& b) { return a.mHash < b.mHash; });
+      v.erase(std::unique(v.begin(), v.end(), [](const auto& a, const auto& b) { return a.mHash == b.mHash; }),
+              v.end());
+
+      auto table = details::BuildTable(static_cast<Algorithm>(t), v, options.mGamma, threadCount);
+
+      // Place every value at its rank, leftovers go to the fallback list
+      table.mValues.resize(v.size() - table.mEntry.mNumFallback);
+      std::vector<std::uint8_t> isFallback(v.size(), 1);
+      details::ParallelFor(v.size(), threadCount, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+          for (std::uint32_t level = 0; level < table.mEntry.mNumLevels; level++) {
+            const auto& info = table.mLevels[level];
+            auto        bit  = info.mFirstBit + details::LevelHash(v[i].mHash, level) % info.mNumBits;
+            if (!(table.mWords[bit / 64] & (std::uint64_t(1) << (bit % 64)))) continue;
+
+            table.mValues[details::Rank(table.mWords.data(), table.mRanks.data(), bit)] = v[i];
+            isFallback[i] = 0;
+            break;
+          }
+        }
+      });
+      for (std::size_t i = 0; i < v.size(); i++)
+        if (isFallback[i]) table.mFallback.push_back(v[i]);
+
+      tables.push_back(std::move(table));
+    }
+
+    // Lay the image out in memory, then write it in one go
+    std::vector<std::uint8_t> image(sizeof(Layout::Header));
+    auto                      append = [&image](const void* data, std::size_t size) {
+      image.resize((image.size() + 7) & ~std::size_t(7));
+      auto position = image.size();
+      image.insert(image.end(), static_cast<const std::uint8_t*>(data), static_cast<const std::uint8_t*>(data) + size);
+      return static_cast<std::uint64_t>(position);
+    };
+    auto appendVector = [&append](const auto& vector) {
+      return append(vector.data(), vector.size() * sizeof(vector[0]));
+    };
+
+    Layout::Header header{};
+    header.mMagic      = Layout::kMagic;
+    header.mVersion    = Layout::kVersion;
+    header.mNumStrings = static_cast<std::uint32_t>(strings.size());
+    header.mNumTables  = static_cast<std::uint32_t>(tables.size());
+
+    std::vector<std::uint32_t> stringOffsets{0};
+    std::vector<char>          stringData;
+    for (auto str : strings) {
+      stringData.insert(stringData.end(), str.begin(), str.end());
+      stringData.push_back('\0');
+      stringOffsets.push_back(static_cast<std::uint32_t>(stringData.size()));
+    }
+    header.mStringOffsets = appendVector(stringOffsets);
+    header.mStringData    = appendVector(stringData);
+
+    for (auto& table : tables) {
+      table.mEntry.mLevels   = appendVector(table.mLevels);
+      table.mEntry.mWords    = appendVector(table.mWords);
+      table.mEntry.mRanks    = appendVector(table.mRanks);
+      table.mEntry.mValues   = appendVector(table.mValues);
+      table.mEntry.mFallback = appendVector(table.mFallback);
+    }
+    std::vector<Layout::TableEntry> tableEntries;
+    for (const auto& table : tables) tableEntries.push_back(table.mEntry);
+    header.mTables = appendVector(tableEntries);
+
+    std::memcpy(image.data(), &header, sizeof(header));
+    os.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+    return !!os;
+  }
+}  // namespace HashDictionary
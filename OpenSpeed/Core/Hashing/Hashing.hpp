@@ -0,0 +1,140 @@
+// clang-format off
+//
+//    Hashing: A header-only library of constexpr native game hash functions. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <cstddef>  // size_t
+#include <cstdint>  // integer types
+
+namespace Hashing {
+  namespace details {
+    struct JenkinsState {
+      std::uint32_t a, b, c;
+    };
+
+    constexpr void JenkinsMix(JenkinsState& s) {
+      s.a -= s.b, s.a -= s.c, s.a ^= (s.c >> 13);
+      s.b -= s.c, s.b -= s.a, s.b ^= (s.a << 8);
+      s.c -= s.a, s.c -= s.b, s.c ^= (s.b >> 13);
+      s.a -= s.b, s.a -= s.c, s.a ^= (s.c >> 12);
+      s.b -= s.c, s.b -= s.a, s.b ^= (s.a << 16);
+      s.c -= s.a, s.c -= s.b, s.c ^= (s.b >> 5);
+      s.a -= s.b, s.a -= s.c, s.a ^= (s.c >> 3);
+      s.b -= s.c, s.b -= s.a, s.b ^= (s.a << 10);
+      s.c -= s.a, s.c -= s.b, s.c ^= (s.b >> 15);
+    }
+
+    constexpr std::uint32_t Byte(const char* data, std::size_t idx, std::uint32_t shift = 0) {
+      return static_cast<std::uint32_t>(static_cast<std::uint8_t>(data[idx])) << shift;
+    }
+    constexpr std::uint32_t Word(const char* data, std::size_t idx) {
+      return Byte(data, idx) | Byte(data, idx + 1, 8) | Byte(data, idx + 2, 16) | Byte(data, idx + 3, 24);
+    }
+
+    constexpr std::size_t Length(const char* str) {
+      std::size_t length = 0;
+      while (str[length]) length++;
+      return length;
+    }
+
+    constexpr std::uint32_t BStringStep(std::uint32_t hash, char c) {
+      return hash * 33 + static_cast<std::uint32_t>(static_cast<signed char>(c));
+    }
+  }  // namespace details
+
+  // Bob Jenkins' lookup2 hash over bytes, as the games' hash32
+  constexpr std::uint32_t Jenkins(const char* data, std::size_t length, std::uint32_t initval) {
+    details::JenkinsState s = {0x9E3779B9, 0x9E3779B9, initval};
+
+    std::size_t idx = 0;
+    for (; length - idx >= 12; idx += 12) {
+      s.a += details::Word(data, idx);
+      s.b += details::Word(data, idx + 4);
+      s.c += details::Word(data, idx + 8);
+      details::JenkinsMix(s);
+    }
+
+    // First byte of 'c' is reserved for the length
+    s.c += static_cast<std::uint32_t>(length);
+    switch (length - idx) {
+      case 11: s.c += details::Byte(data, idx + 10, 24); [[fallthrough]];
+      case 10: s.c += details::Byte(data, idx + 9, 16); [[fallthrough]];
+      case 9: s.c += details::Byte(data, idx + 8, 8); [[fallthrough]];
+      case 8: s.b += details::Byte(data, idx + 7, 24); [[fallthrough]];
+      case 7: s.b += details::Byte(data, idx + 6, 16); [[fallthrough]];
+      case 6: s.b += details::Byte(data, idx + 5, 8); [[fallthrough]];
+      case 5: s.b += details::Byte(data, idx + 4); [[fallthrough]];
+      case 4: s.a += details::Byte(data, idx + 3, 24); [[fallthrough]];
+      case 3: s.a += details::Byte(data, idx + 2, 16); [[fallthrough]];
+      case 2: s.a += details::Byte(data, idx + 1, 8); [[fallthrough]];
+      case 1: s.a += details::Byte(data, idx); [[fallthrough]];
+      default: break;
+    }
+    details::JenkinsMix(s);
+    return s.c;
+  }
+
+  // stringhash32/Attrib::StringToKey: Jenkins with the 0xABCDEF00 magic, null or empty strings are 0
+  constexpr std::uint32_t StringHash32(const char* str, std::size_t length) {
+    return (!str || !length) ? 0 : Jenkins(str, length, 0xABCDEF00);
+  }
+  constexpr std::uint32_t StringHash32(const char* str) { return str ? StringHash32(str, details::Length(str)) : 0; }
+
+  // Keys as stored in the games' vaults: the pvehicle class and the default collection
+  static_assert(StringHash32("pvehicle") == 0x4A97EC8F, "StringHash32 doesn't match the game.");
+  static_assert(StringHash32("default") == 0xEEC2271A, "StringHash32 doesn't match the game.");
+
+  // bStringHash: h = h * 33 + c from 0xFFFFFFFF, chars are signed as in the games; null strings are 0
+  constexpr std::uint32_t BStringHash(const char* str, std::size_t length) {
+    if (!str) return 0;
+
+    std::uint32_t hash = 0xFFFFFFFF;
+    for (std::size_t i = 0; i < length; i++) hash = details::BStringStep(hash, str[i]);
+    return hash;
+  }
+  constexpr std::uint32_t BStringHash(const char* str) { return str ? BStringHash(str, details::Length(str)) : 0; }
+
+  //         //
+  // Batches //
+  //         //
+
+  // Hash 'count' null-terminated strings into 'out'; bStringHash runs 4 strings side by side to hide its latency
+  inline void BStringHash(const char* const* strings, std::size_t count, std::uint32_t* out) {
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+      const char* s[4] = {strings[i], strings[i + 1], strings[i + 2], strings[i + 3]};
+      if (!s[0] || !s[1] || !s[2] || !s[3]) {
+        for (std::size_t lane = 0; lane < 4; lane++) out[i + lane] = BStringHash(s[lane]);
+        continue;
+      }
+
+      std::uint32_t h[4] = {0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF};
+      while (*s[0] && *s[1] && *s[2] && *s[3])
+        for (std::size_t lane = 0; lane < 4; lane++) h[lane] = details::BStringStep(h[lane], *s[lane]++);
+      for (std::size_t lane = 0; lane < 4; lane++) {
+        while (*s[lane]) h[lane] = details::BStringStep(h[lane], *s[lane]++);
+        out[i + lane] = h[lane];
+      }
+    }
+    for (; i < count; i++) out[i] = BStringHash(strings[i]);
+  }
+  inline void StringHash32(const char* const* strings, std::size_t count, std::uint32_t* out) {
+    for (std::size_t i = 0; i < count; i++) out[i] = StringHash32(strings[i]);
+  }
+}  // namespace Hashing
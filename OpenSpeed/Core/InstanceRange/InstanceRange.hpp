@@ -0,0 +1,100 @@
+// clang-format off
+//
+//    InstanceRange: A header-only library for allocation-free loops and ranges over game instance lists. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <cstddef>      // ptrdiff_t
+#include <iterator>     // input_iterator_tag
+#include <type_traits>  // invoke_result_t, is_same_v
+
+namespace InstanceRange {
+  // Every cursor has 'using value_type' and 'bool Advance(value_type& out)', which moves to the next valid item
+  // and returns false past the last one. Cursors must be cheap to copy and default constructible.
+
+  // Calls fn(item); callbacks returning exactly bool stop the loop on false, any other result is discarded as it
+  // was with std::function<void(T)>. Returns whether to go on.
+  template <typename Fn, typename T>
+  bool Invoke(Fn& fn, T item) {
+    if constexpr (std::is_same_v<std::invoke_result_t<Fn&, T>, bool>) {
+      return fn(item);
+    } else {
+      fn(item);
+      return true;
+    }
+  }
+
+  template <typename Cursor, typename Fn>
+  void ForEach(Cursor cursor, Fn&& fn) {
+    typename Cursor::value_type item{};
+    while (cursor.Advance(item))
+      if (!Invoke(fn, item)) return;
+  }
+
+  struct Sentinel {};
+
+  // Single pass range; works with range-for, and with std::ranges as an input range under C++20
+  // Usage: for (auto* item : InstanceRange::Range<MyCursor>()) ...
+  template <typename Cursor>
+  class Range {
+    Cursor mCursor{};
+
+   public:
+    using value_type = typename Cursor::value_type;
+
+    class iterator {
+     public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type        = typename Cursor::value_type;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = const value_type*;
+      using reference         = value_type;
+
+     private:
+      Cursor     mCursor;
+      value_type mItem{};
+      bool       mIsEnd = true;
+
+     public:
+      iterator() = default;
+      explicit iterator(const Cursor& cursor) : mCursor(cursor) { ++*this; }
+
+      value_type operator*() const { return mItem; }
+      iterator&  operator++() {
+        mIsEnd = !mCursor.Advance(mItem);
+        return *this;
+      }
+      iterator operator++(int) {
+        auto copy = *this;
+        ++*this;
+        return copy;
+      }
+
+      friend bool operator==(const iterator& it, Sentinel) { return it.mIsEnd; }
+      friend bool operator==(Sentinel, const iterator& it) { return it.mIsEnd; }
+      friend bool operator!=(const iterator& it, Sentinel) { return !it.mIsEnd; }
+      friend bool operator!=(Sentinel, const iterator& it) { return !it.mIsEnd; }
+    };
+
+    Range() = default;
+    explicit Range(const Cursor& cursor) : mCursor(cursor) {}
+
+    iterator begin() const { return iterator(mCursor); }
+    Sentinel end() const { return {}; }
+  };
+}  // namespace InstanceRange
@@ -0,0 +1,125 @@
+// clang-format off
+//
+//    InstanceTable: Header-only bounded views over game instance tables with per-frame cached counts. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <cstddef>      // size_t
+#include <type_traits>  // is_same_v
+
+#include <OpenSpeed/Core/InstanceRange/InstanceRange.hpp>  // InstanceRange::Range
+#include <OpenSpeed/Core/IntrusiveList/IntrusiveList.hpp>  // IntrusiveList::Range
+
+namespace InstanceTable {
+  // Neither view validates the instances it returns, that is up to the caller.
+
+  // Null-terminated array of 'Entry', which is either 'T*' or a struct with a 'T* mInstance' member.
+  // Reads never go past MaxN entries, even if the table is full and has no terminator.
+  // Usage: InstanceTable::Table<Volatile, 64> table(Volatile::g_mInstances); table.GetCount();
+  template <typename T, std::size_t MaxN, typename Entry = T*>
+  class Table {
+    static T* GetInstance(const Entry& entry) {
+      if constexpr (std::is_same_v<Entry, T*>)
+        return entry;
+      else
+        return entry.mInstance;
+    }
+
+    const Entry* mEntries;
+
+   public:
+    using value_type                       = T*;
+    static constexpr std::size_t kCapacity = MaxN;
+
+    struct Cursor {
+      using value_type = T*;
+
+      const Entry* mEntry = nullptr;
+      const Entry* mEnd   = nullptr;
+
+      bool Advance(T*& out) {
+        if (mEntry == mEnd) return false;
+
+        out = GetInstance(*mEntry++);
+        return out != nullptr;
+      }
+    };
+
+    explicit Table(const Entry* entries) : mEntries(entries) {}
+
+    // Entries before the terminator, walked on every call as the game can spawn at any time
+    std::size_t GetCount() const {
+      std::size_t count = 0;
+      while (count < MaxN && GetInstance(mEntries[count])) count++;
+      return count;
+    }
+
+    // Unchecked, 'idx' must be below GetCount()
+    T* operator[](std::size_t idx) const { return GetInstance(mEntries[idx]); }
+    // nullptr past the terminator, walks up to 'idx' so iterate instead of calling it in a loop
+    T* At(std::size_t idx) const {
+      for (std::size_t i = 0; i < idx && i < MaxN; i++)
+        if (!GetInstance(mEntries[i])) return nullptr;
+      return idx < MaxN ? (*this)[idx] : nullptr;
+    }
+
+    // Stops at the terminator or MaxN
+    Cursor GetCursor() const { return {mEntries, mEntries + MaxN}; }
+    auto   begin() const { return InstanceRange::Range<Cursor>(GetCursor()).begin(); }
+    auto   end() const { return InstanceRange::Sentinel{}; }
+  };
+
+  // Circular intrusive list whose head node is the list pointer itself (bTList style). 'Node' needs GetNext()
+  // and 'T' must derive from it. Refresh() copies the nodes into a flat array for random access, everything else
+  // reads that copy until the next Refresh(); lists longer than MaxN are cut at MaxN, see IntrusiveList::Range for
+  // how broken lists are handled.
+  // Usage: InstanceTable::ListTable<PVehicle, 64, bTNode<PVehicle*>> table(PVehicle::g_mInstances); table.Refresh();
+  template <typename T, std::size_t MaxN, typename Node>
+  class ListTable {
+    Node**              mHead;
+    mutable T*          mInstances[MaxN];
+    mutable std::size_t mCount = 0;
+
+   public:
+    using value_type                       = T*;
+    static constexpr std::size_t kCapacity = MaxN;
+
+    explicit ListTable(Node** head) : mHead(head) {}
+
+    // Walk the list again, returns the instance count
+    std::size_t Refresh() const {
+      mCount = 0;
+      if (mHead) {
+        IntrusiveList::Range<T, Node> list(reinterpret_cast<Node*>(mHead), MaxN);
+        mCount = list.Materialize(mInstances, MaxN);
+      }
+      return mCount;
+    }
+    // Instances seen by the last Refresh()
+    std::size_t GetCount() const { return mCount; }
+
+    // Unchecked, reads the array from the last Refresh()
+    T* operator[](std::size_t idx) const { return mInstances[idx]; }
+    // nullptr past the last instance seen by Refresh()
+    T* At(std::size_t idx) const { return idx < mCount ? mInstances[idx] : nullptr; }
+
+    // Iterates the array from the last Refresh()
+    T* const* begin() const { return mInstances; }
+    T* const* end() const { return mInstances + mCount; }
+  };
+}  // namespace InstanceTable
@@ -0,0 +1,136 @@
+// clang-format off
+//
+//    IntrusiveList: Header-only prefetching, cycle-safe ranges over circular intrusive lists. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <cstddef>      // size_t, ptrdiff_t
+#include <iterator>     // forward_iterator_tag
+#include <vector>       // vector
+#include <xmmintrin.h>  // _mm_prefetch
+
+namespace IntrusiveList {
+  // Lists are circular with a sentinel head node (bTList/bPList style); 'Node' needs GetNext().
+  // Walks stop at the head, at a null link or after 'maxLength' nodes. A cycle that skips the head is caught a
+  // few nodes after it closes, so some items may be seen twice in a broken list, but the walk always ends.
+
+  // Node -> item for lists whose items derive from their node (bTList<T>)
+  template <typename T>
+  struct NodeCast {
+    template <typename Node>
+    T* operator()(Node* node) const {
+      return static_cast<T*>(node);
+    }
+  };
+  // Node -> item for lists whose nodes point at their item (bPList<T>, PNode being bPNode)
+  template <typename T, typename PNode>
+  struct ObjectCast {
+    template <typename Node>
+    T* operator()(Node* node) const {
+      return static_cast<T*>(static_cast<PNode*>(node)->Object);
+    }
+  };
+
+  static constexpr std::size_t kDefaultMaxLength = 4096;
+
+  // Usage: for (auto* prim : IntrusiveList::Range<Primitive, bTNode<Primitive>>(&list.HeadNode)) ...
+  template <typename T, typename Node, typename Cast = NodeCast<T>, std::size_t Ahead = 4>
+  class Range {
+    Node*       mHead;
+    std::size_t mMaxLength;
+
+   public:
+    class iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = T*;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = T* const*;
+      using reference         = T*;
+
+     private:
+      Node*       mHead     = nullptr;
+      Node*       mNode     = nullptr;
+      Node*       mAhead    = nullptr;  // 'Ahead' nodes past mNode, prefetched
+      Node*       mCheck    = nullptr;  // Brent's cycle check
+      std::size_t mPower    = 1;
+      std::size_t mSteps    = 0;
+      std::size_t mMaxSteps = 0;
+
+      bool IsLink(Node* node) const { return node && node != mHead; }
+
+     public:
+      iterator() = default;
+      iterator(Node* head, std::size_t maxLength) : mHead(head), mCheck(head), mMaxSteps(maxLength) {
+        mNode  = head ? head->GetNext() : nullptr;
+        mAhead = mNode;
+        for (std::size_t i = 0; i < Ahead && IsLink(mAhead); i++) {
+          mAhead = mAhead->GetNext();
+          if (IsLink(mAhead)) _mm_prefetch(reinterpret_cast<const char*>(mAhead), _MM_HINT_T0);
+        }
+        if (!IsLink(mNode) || mMaxSteps == 0) mNode = nullptr;
+      }
+
+      T* operator*() const { return Cast()(mNode); }
+      iterator& operator++() {
+        mNode = mNode->GetNext();
+        if (IsLink(mAhead)) {
+          mAhead = mAhead->GetNext();
+          if (IsLink(mAhead)) _mm_prefetch(reinterpret_cast<const char*>(mAhead), _MM_HINT_T0);
+        }
+
+        // Meeting the saved node again means we are going round a loop the head isn't part of
+        if (++mSteps == mMaxSteps || !IsLink(mNode) || mNode == mCheck) {
+          mNode = nullptr;
+          return *this;
+        }
+        if (mSteps == mPower) {
+          mCheck = mNode;
+          mPower <<= 1;
+        }
+        return *this;
+      }
+      iterator operator++(int) {
+        auto copy = *this;
+        ++*this;
+        return copy;
+      }
+
+      bool operator==(const iterator& rhs) const { return mNode == rhs.mNode; }
+      bool operator!=(const iterator& rhs) const { return mNode != rhs.mNode; }
+    };
+
+    explicit Range(Node* head, std::size_t maxLength = kDefaultMaxLength) : mHead(head), mMaxLength(maxLength) {}
+
+    iterator begin() const { return iterator(mHead, mMaxLength); }
+    iterator end() const { return {}; }
+
+    // Copy the items into 'out' for repeated passes, returns how many were added
+    std::size_t Materialize(std::vector<T*>& out) const {
+      const auto size = out.size();
+      for (auto* item : *this) out.push_back(item);
+      return out.size() - size;
+    }
+    // Same into a fixed buffer, stops at 'capacity'
+    std::size_t Materialize(T** out, std::size_t capacity) const {
+      std::size_t count = 0;
+      for (auto it = begin(); it != end() && count < capacity; ++it) out[count++] = *it;
+      return count;
+    }
+  };
+}  // namespace IntrusiveList
@@ -0,0 +1,120 @@
+// clang-format off
+//
+//    LockFreeQueue: A header-only bounded multi-producer queue with all-or-nothing batch pushes. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <atomic>       // atomic
+#include <cstddef>      // size_t, ptrdiff_t
+#include <type_traits>  // is_trivially_copyable_v
+
+namespace LockFreeQueue {
+  // Bounded ring with a sequence number per cell (Vyukov style). Any thread may push; pops must come from one
+  // thread at a time. Items come out in the order their pushes claimed a slot, and a batch always stays together:
+  // its first item is published last, so once that one can be popped the rest of the batch can be too.
+  // Usage: LockFreeQueue::Queue<Item, 256> queue; queue.TryPush(item); ... while (queue.TryPop(item)) ...
+  template <typename T, std::size_t N>
+  class Queue {
+    static_assert(N && (N & (N - 1)) == 0, "N must be a power of two.");
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
+
+    struct Cell {
+      std::atomic<std::size_t> mSequence;
+      T                        mData;
+    };
+
+    Cell                                 mCells[N];
+    alignas(64) std::atomic<std::size_t> mPushPos{0};
+    alignas(64) std::atomic<std::size_t> mPopPos{0};
+
+   public:
+    static constexpr std::size_t kCapacity = N;
+
+    Queue() {
+      for (std::size_t i = 0; i < N; i++) mCells[i].mSequence.store(i, std::memory_order_relaxed);
+    }
+    Queue(const Queue&)            = delete;
+    Queue& operator=(const Queue&) = delete;
+
+    // Returns false if the queue is full
+    bool TryPush(const T& item) { return TryPush(&item, 1); }
+    // Pushes all 'count' items next to each other, or none of them if there isn't room
+    bool TryPush(const T* items, std::size_t count) {
+      if (count == 0) return true;
+      if (count > N) return false;
+
+      auto pos = mPushPos.load(std::memory_order_relaxed);
+      for (;;) {
+        // Cells free up in order, so if the last cell of the range is free the whole range is
+        const auto& last = mCells[(pos + count - 1) & (N - 1)];
+        const auto  diff = static_cast<std::ptrdiff_t>(last.mSequence.load(std::memory_order_acquire) -
+                                                      (pos + count - 1));
+        if (diff < 0) return false;
+        if (diff > 0) {
+          pos = mPushPos.load(std::memory_order_relaxed);
+          continue;
+        }
+        if (mPushPos.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) break;
+      }
+
+      for (std::size_t i = count; i-- > 0;) {
+        auto& cell = mCells[(pos + i) & (N - 1)];
+        cell.mData = items[i];
+        cell.mSequence.store(pos + i + 1, std::memory_order_release);
+      }
+      return true;
+    }
+
+    // Same as TryPop() but leaves the item in the queue, popping thread only
+    bool TryPeek(T& out) const {
+      const auto  pos  = mPopPos.load(std::memory_order_relaxed);
+      const auto& cell = mCells[pos & (N - 1)];
+      if (cell.mSequence.load(std::memory_order_acquire) != pos + 1) return false;
+
+      out = cell.mData;
+      return true;
+    }
+    // Returns false if the queue is empty, or the next item's push hasn't finished yet
+    bool TryPop(T& out) {
+      const auto pos  = mPopPos.load(std::memory_order_relaxed);
+      auto&      cell = mCells[pos & (N - 1)];
+      if (cell.mSequence.load(std::memory_order_acquire) != pos + 1) return false;
+
+      out = cell.mData;
+      cell.mSequence.store(pos + N, std::memory_order_release);
+      mPopPos.store(pos + 1, std::memory_order_relaxed);
+      return true;
+    }
+    // Pops up to 'max' items into fn(item), returns how many
+    template <typename Fn>
+    std::size_t Drain(Fn&& fn, std::size_t max = N) {
+      std::size_t count = 0;
+      T           item;
+      while (count < max && TryPop(item)) {
+        fn(item);
+        count++;
+      }
+      return count;
+    }
+
+    // Approximate while pushes are in flight
+    std::size_t GetSize() const {
+      return mPushPos.load(std::memory_order_relaxed) - mPopPos.load(std::memory_order_relaxed);
+    }
+  };
+}  // namespace LockFreeQueue
@@ -0,0 +1,123 @@
+// clang-format off
+//
+//    MemorySnapshot: A header-only library to read 32-bit game memory live or from captured snapshots. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <cstdint>      // integer types
+#include <cstring>      // memcpy
+#include <istream>      // istream
+#include <map>          // map
+#include <ostream>      // ostream
+#include <type_traits>  // is_trivially_copyable
+#include <utility>      // move
+#include <vector>       // vector
+
+namespace MemorySnapshot {
+  // The games are 32-bit, so are their pointers
+  using Address = std::uint32_t;
+
+  // Every source has 'bool Read(Address address, void* out, std::size_t size) const'
+
+  // Reads the current process' memory; only meaningful in the game's process
+  struct LiveMemory {
+    bool Read(Address address, void* out, std::size_t size) const {
+      if (!address) return false;
+
+      std::memcpy(out, reinterpret_cast<const void*>(static_cast<std::uintptr_t>(address)), size);
+      return true;
+    }
+  };
+
+  // Captured memory regions keyed by their base address
+  class Snapshot {
+    std::map<Address, std::vector<std::uint8_t>> mRegions;
+
+    static constexpr std::uint32_t kMagic = 0x534D534F;  // OSMS
+
+   public:
+    void AddRegion(Address base, const void* data, std::size_t size) {
+      auto& region = mRegions[base];
+      region.assign(static_cast<const std::uint8_t*>(data), static_cast<const std::uint8_t*>(data) + size);
+    }
+    // Copy a region from another source, e.g. LiveMemory
+    template <typename Source>
+    bool Capture(const Source& source, Address base, std::size_t size) {
+      std::vector<std::uint8_t> data(size);
+      if (!source.Read(base, data.data(), size)) return false;
+
+      mRegions[base] = std::move(data);
+      return true;
+    }
+    void Clear() { mRegions.clear(); }
+
+    // Pointer to 'size' bytes at 'address' if a single region holds all of them
+    const std::uint8_t* Find(Address address, std::size_t size) const {
+      auto it = mRegions.upper_bound(address);
+      if (it == mRegions.begin()) return nullptr;
+
+      --it;
+      std::uint64_t offset = address - it->first;
+      if (offset + size > it->second.size()) return nullptr;
+      return it->second.data() + offset;
+    }
+    bool Read(Address address, void* out, std::size_t size) const {
+      auto* data = Find(address, size);
+      if (!data) return false;
+
+      std::memcpy(out, data, size);
+      return true;
+    }
+
+    // Layout: magic, region count, then { base, size, bytes } per region; little-endian
+    void Save(std::ostream& os) const {
+      auto write = [&os](std::uint32_t v) { os.write(reinterpret_cast<const char*>(&v), sizeof(v)); };
+      write(kMagic);
+      write(static_cast<std::uint32_t>(mRegions.size()));
+      for (const auto& [base, data] : mRegions) {
+        write(base);
+        write(static_cast<std::uint32_t>(data.size()));
+        os.write(reinterpret_cast<const char*>(data.data()), data.size());
+      }
+    }
+    bool Load(std::istream& is) {
+      auto read = [&is](std::uint32_t& v) { return !!is.read(reinterpret_cast<char*>(&v), sizeof(v)); };
+
+      std::uint32_t magic = 0, count = 0;
+      if (!read(magic) || magic != kMagic || !read(count)) return false;
+
+      mRegions.clear();
+      for (std::uint32_t i = 0; i < count; i++) {
+        std::uint32_t base = 0, size = 0;
+        if (!read(base) || !read(size)) return false;
+
+        auto& data = mRegions[base];
+        data.resize(size);
+        if (!is.read(reinterpret_cast<char*>(data.data()), size)) return false;
+      }
+      return true;
+    }
+  };
+
+  // Usage: MyLayout value; if (MemorySnapshot::ReadValue(source, address, value)) ...
+  template <typename T, typename Source>
+  bool ReadValue(const Source& source, Address address, T& out) {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
+    return source.Read(address, &out, sizeof(T));
+  }
+}  // namespace MemorySnapshot
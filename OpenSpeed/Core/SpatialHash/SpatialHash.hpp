@@ -0,0 +1,207 @@
+// clang-format off
+//
+//    SpatialHash: A header-only uniform spatial hash for radius, k-nearest and cone queries. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <algorithm>  // max, sort, push_heap, pop_heap
+#include <cmath>      // floor, sqrt
+#include <cstdint>    // integer types
+#include <vector>     // vector
+
+namespace SpatialHash {
+  // Uniform grid on the horizontal (X/Y) plane with Z up, as the games' UMath names their axes, hashed into a bucket
+  // table and rebuilt in one pass per frame. Distances are full 3D, only bucketing ignores the vertical axis.
+  template <typename T>
+  class HashGrid {
+   public:
+    struct Result {
+      T     mItem;
+      float mDistanceSquared;
+    };
+
+   protected:
+    struct Entry {
+      T            mItem;
+      float        mX, mY, mZ;
+      std::int32_t mCellX, mCellY;
+    };
+
+    float                      mCellSize    = 50.0f;
+    float                      mInvCellSize = 1.0f / 50.0f;
+    std::uint32_t              mMask        = 0;
+    std::int32_t               mMinCellX = 0, mMinCellY = 0, mMaxCellX = -1, mMaxCellY = -1;
+    std::vector<Entry>         mPending;
+    std::vector<Entry>         mEntries;
+    std::vector<std::uint32_t> mBucketStart;
+    std::vector<std::uint32_t> mCursor;  // Build() scratch, kept so rebuilding reuses its memory
+
+    std::int32_t ToCell(float v) const { return static_cast<std::int32_t>(std::floor(v * mInvCellSize)); }
+    std::uint32_t Hash(std::int32_t cellX, std::int32_t cellY) const {
+      return (static_cast<std::uint32_t>(cellX) * 73856093u ^ static_cast<std::uint32_t>(cellY) * 19349663u) & mMask;
+    }
+
+    // Visit the entries of a single cell, skipping others sharing its bucket
+    template <typename Fn>
+    void ForEachInCell(std::int32_t cellX, std::int32_t cellY, Fn&& fn) const {
+      if (mEntries.empty()) return;
+
+      auto bucket = Hash(cellX, cellY);
+      for (auto i = mBucketStart[bucket]; i < mBucketStart[bucket + 1]; i++) {
+        const auto& entry = mEntries[i];
+        if (entry.mCellX == cellX && entry.mCellY == cellY) fn(entry);
+      }
+    }
+
+    static float DistanceSquared(const Entry& entry, float x, float y, float z) {
+      float dx = entry.mX - x, dy = entry.mY - y, dz = entry.mZ - z;
+      return dx * dx + dy * dy + dz * dz;
+    }
+
+    template <typename Fn>
+    void ForEachInRadius(float x, float y, float z, float radius, Fn&& fn) const {
+      const float radiusSquared = radius * radius;
+
+      const auto minX = std::max(ToCell(x - radius), mMinCellX), maxX = std::min(ToCell(x + radius), mMaxCellX);
+      const auto minY = std::max(ToCell(y - radius), mMinCellY), maxY = std::min(ToCell(y + radius), mMaxCellY);
+      for (auto cellX = minX; cellX <= maxX; cellX++) {
+        for (auto cellY = minY; cellY <= maxY; cellY++) {
+          ForEachInCell(cellX, cellY, [&](const Entry& entry) {
+            float distanceSquared = DistanceSquared(entry, x, y, z);
+            if (distanceSquared <= radiusSquared) fn(entry, distanceSquared);
+          });
+        }
+      }
+    }
+
+   public:
+    void SetCellSize(float cellSize) {
+      mCellSize    = cellSize;
+      mInvCellSize = 1.0f / cellSize;
+    }
+    float GetCellSize() const { return mCellSize; }
+
+    // Drop every item, call before re-adding for the next frame
+    void Clear() {
+      mPending.clear();
+      mEntries.clear();
+      mBucketStart.clear();
+    }
+    // Queue an item, nothing is queryable until Build()
+    void Add(const T& item, float x, float y, float z) { mPending.push_back({item, x, y, z, ToCell(x), ToCell(y)}); }
+
+    // Counting-sort queued items into the bucket table
+    void Build() {
+      std::uint32_t bucketCount = 1;
+      while (bucketCount < mPending.size() * 2) bucketCount <<= 1;
+      mMask = bucketCount - 1;
+
+      mBucketStart.assign(bucketCount + 1, 0);
+      mEntries.resize(mPending.size());
+      if (mPending.empty()) return;
+
+      mMinCellX = mMaxCellX = mPending.front().mCellX;
+      mMinCellY = mMaxCellY = mPending.front().mCellY;
+      for (const auto& entry : mPending) {
+        mBucketStart[Hash(entry.mCellX, entry.mCellY) + 1]++;
+        mMinCellX = std::min(mMinCellX, entry.mCellX);
+        mMaxCellX = std::max(mMaxCellX, entry.mCellX);
+        mMinCellY = std::min(mMinCellY, entry.mCellY);
+        mMaxCellY = std::max(mMaxCellY, entry.mCellY);
+      }
+      for (std::uint32_t i = 0; i < bucketCount; i++) mBucketStart[i + 1] += mBucketStart[i];
+
+      mCursor.assign(mBucketStart.begin(), mBucketStart.end() - 1);
+      for (const auto& entry : mPending) mEntries[mCursor[Hash(entry.mCellX, entry.mCellY)]++] = entry;
+    }
+
+    std::size_t GetCount() const { return mEntries.size(); }
+
+    // Run a function on every item within 'radius', fn(const T& item, float distanceSquared)
+    template <typename Fn>
+    void QueryRadius(float x, float y, float z, float radius, Fn&& fn) const {
+      ForEachInRadius(x, y, z, radius,
+                      [&](const Entry& entry, float distanceSquared) { fn(entry.mItem, distanceSquared); });
+    }
+
+    // Run a function on every item within 'radius' and inside the cone around 'forward'
+    // 'cosHalfAngle' is the cosine of the cone's half angle, 'forward' doesn't need to be normalized
+    template <typename Fn>
+    void QueryCone(float x, float y, float z, float forwardX, float forwardY, float forwardZ, float cosHalfAngle,
+                   float radius, Fn&& fn) const {
+      const float forwardLength = std::sqrt(forwardX * forwardX + forwardY * forwardY + forwardZ * forwardZ);
+      if (forwardLength <= 0.0f) return;
+
+      // Compare squared to skip the per-item sqrt
+      const float cosSquared = cosHalfAngle * cosHalfAngle;
+      ForEachInRadius(x, y, z, radius, [&](const Entry& entry, float distanceSquared) {
+        if (distanceSquared <= 0.0f) return;
+
+        float dot = ((entry.mX - x) * forwardX + (entry.mY - y) * forwardY + (entry.mZ - z) * forwardZ) / forwardLength;
+        if (cosHalfAngle >= 0.0f ? (dot > 0.0f && dot * dot >= cosSquared * distanceSquared)
+                                 : (dot >= 0.0f || dot * dot <= cosSquared * distanceSquared))
+          fn(entry.mItem, distanceSquared);
+      });
+    }
+
+    // Collect up to 'k' nearest items accepted by 'filter', sorted by distance, filter(const T& item) -> bool
+    template <typename Filter>
+    void QueryKNearest(float x, float y, float z, std::size_t k, std::vector<Result>& out, Filter&& filter) const {
+      out.clear();
+      if (!k || mEntries.empty()) return;
+
+      auto farther = [](const Result& lhs, const Result& rhs) { return lhs.mDistanceSquared < rhs.mDistanceSquared; };
+      auto visit   = [&](const Entry& entry) {
+        if (!filter(entry.mItem)) return;
+
+        float distanceSquared = DistanceSquared(entry, x, y, z);
+        if (out.size() < k) {
+          out.push_back({entry.mItem, distanceSquared});
+          std::push_heap(out.begin(), out.end(), farther);
+        } else if (distanceSquared < out.front().mDistanceSquared) {
+          std::pop_heap(out.begin(), out.end(), farther);
+          out.back() = {entry.mItem, distanceSquared};
+          std::push_heap(out.begin(), out.end(), farther);
+        }
+      };
+
+      // Walk square rings outwards; anything outside ring 'r' is at least r * cellSize away
+      const auto centerX = ToCell(x), centerY = ToCell(y);
+      const auto maxRing = std::max(std::max(centerX - mMinCellX, mMaxCellX - centerX),
+                                    std::max(centerY - mMinCellY, mMaxCellY - centerY));
+      for (std::int32_t ring = 0; ring <= maxRing; ring++) {
+        if (out.size() == k) {
+          float reach = (ring - 1) * mCellSize;
+          if (out.front().mDistanceSquared <= reach * reach) break;
+        }
+        for (auto cellX = centerX - ring; cellX <= centerX + ring; cellX++) {
+          if (cellX < mMinCellX || cellX > mMaxCellX) continue;
+
+          const bool isEdge = cellX == centerX - ring || cellX == centerX + ring;
+          for (auto cellY = centerY - ring; cellY <= centerY + ring; cellY += isEdge ? 1 : 2 * ring) {
+            if (cellY >= mMinCellY && cellY <= mMaxCellY) ForEachInCell(cellX, cellY, visit);
+          }
+        }
+      }
+      std::sort_heap(out.begin(), out.end(), farther);
+    }
+    void QueryKNearest(float x, float y, float z, std::size_t k, std::vector<Result>& out) const {
+      QueryKNearest(x, y, z, k, out, [](const T&) { return true; });
+    }
+  };
+}  // namespace SpatialHash
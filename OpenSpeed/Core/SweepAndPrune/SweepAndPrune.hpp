@@ -0,0 +1,277 @@
+// clang-format off
+//
+//    SweepAndPrune: A header-only 2D sweep-and-prune broadphase with persistent pairs. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <cstdint>        // integer types
+#include <limits>         // numeric_limits
+#include <unordered_map>  // unordered_map
+#include <utility>        // swap
+#include <vector>         // vector
+
+namespace SweepAndPrune {
+  // Broadphase over the two horizontal axes the game's Grid<T> sorts on (X, Z).
+  // Endpoints are kept sorted per axis and moved with insertion sort on update, so frame-to-frame coherent motion
+  // costs close to O(n). Overlapping pairs are persistent and only change when endpoints swap.
+  template <typename T>
+  class Broadphase {
+   public:
+    using Handle = std::uint32_t;
+    static constexpr Handle kInvalidHandle = std::numeric_limits<Handle>::max();
+
+    enum Axis : std::uint32_t { X, Z, AxisCount };
+
+    struct Pair {
+      Handle first;
+      Handle second;
+    };
+
+   protected:
+    struct Endpoint {
+      float         mValue;
+      std::uint32_t mData;  // handle << 1 | isMax
+
+      Handle GetHandle() const { return mData >> 1; }
+      bool   IsMax() const { return mData & 1; }
+    };
+    struct Proxy {
+      T             mUserData;
+      float         mMin[AxisCount];
+      float         mMax[AxisCount];
+      std::uint32_t mMinIdx[AxisCount];
+      std::uint32_t mMaxIdx[AxisCount];
+      bool          mIsUsed;
+    };
+
+    std::vector<Endpoint>                          mEndpoints[AxisCount];
+    std::vector<Proxy>                             mProxies;
+    std::vector<Handle>                            mFreeHandles;
+    std::vector<Pair>                              mPairs;
+    std::unordered_map<std::uint64_t, std::size_t> mPairIndices;
+
+    static std::uint64_t PairKey(Handle a, Handle b) {
+      if (a > b) std::swap(a, b);
+      return (static_cast<std::uint64_t>(a) << 32) | b;
+    }
+
+    // Sort order; on equal values a min endpoint comes first, so touching boxes overlap
+    static bool Less(const Endpoint& lhs, const Endpoint& rhs) {
+      return lhs.mValue < rhs.mValue || (lhs.mValue == rhs.mValue && !lhs.IsMax() && rhs.IsMax());
+    }
+
+    bool OverlapsOnAxis(const Proxy& a, const Proxy& b, std::uint32_t axis) const {
+      return a.mMin[axis] <= b.mMax[axis] && b.mMin[axis] <= a.mMax[axis];
+    }
+
+    void AddPair(Handle a, Handle b) {
+      auto key = PairKey(a, b);
+      if (mPairIndices.count(key)) return;
+
+      mPairIndices.emplace(key, mPairs.size());
+      mPairs.push_back({a < b ? a : b, a < b ? b : a});
+    }
+    void RemovePair(Handle a, Handle b) {
+      auto it = mPairIndices.find(PairKey(a, b));
+      if (it == mPairIndices.end()) return;
+
+      // Swap-remove, patching the moved pair's index
+      std::size_t idx = it->second;
+      mPairIndices.erase(it);
+      if (idx != mPairs.size() - 1) {
+        mPairs[idx]                                                  = mPairs.back();
+        mPairIndices[PairKey(mPairs[idx].first, mPairs[idx].second)] = idx;
+      }
+      mPairs.pop_back();
+    }
+
+    void SetEndpointIndex(std::uint32_t axis, std::uint32_t idx) {
+      const auto& endpoint = mEndpoints[axis][idx];
+      auto&       proxy    = mProxies[endpoint.GetHandle()];
+      if (endpoint.IsMax())
+        proxy.mMaxIdx[axis] = idx;
+      else
+        proxy.mMinIdx[axis] = idx;
+    }
+
+    // Swap endpoint 'idx' with its neighbour 'idx + 1', reporting overlap changes on this axis
+    void SwapUp(std::uint32_t axis, std::uint32_t idx) {
+      auto&        endpoints = mEndpoints[axis];
+      const auto&  moving    = endpoints[idx];
+      const auto&  passed    = endpoints[idx + 1];
+      const Handle a         = moving.GetHandle();
+      const Handle b         = passed.GetHandle();
+
+      if (moving.IsMax() && !passed.IsMax()) {
+        // Our max passes their min: overlap begins on this axis
+        if (OverlapsOnAxis(mProxies[a], mProxies[b], axis ^ 1)) AddPair(a, b);
+      } else if (!moving.IsMax() && passed.IsMax()) {
+        // Our min passes their max: overlap ends on this axis
+        RemovePair(a, b);
+      }
+
+      std::swap(endpoints[idx], endpoints[idx + 1]);
+      SetEndpointIndex(axis, idx);
+      SetEndpointIndex(axis, idx + 1);
+    }
+
+    // Swap endpoint 'idx' with its neighbour 'idx - 1', reporting overlap changes on this axis
+    void SwapDown(std::uint32_t axis, std::uint32_t idx) {
+      auto&        endpoints = mEndpoints[axis];
+      const auto&  moving    = endpoints[idx];
+      const auto&  passed    = endpoints[idx - 1];
+      const Handle a         = moving.GetHandle();
+      const Handle b         = passed.GetHandle();
+
+      if (!moving.IsMax() && passed.IsMax()) {
+        // Our min passes their max: overlap begins on this axis
+        if (OverlapsOnAxis(mProxies[a], mProxies[b], axis ^ 1)) AddPair(a, b);
+      } else if (moving.IsMax() && !passed.IsMax()) {
+        // Our max passes their min: overlap ends on this axis
+        RemovePair(a, b);
+      }
+
+      std::swap(endpoints[idx], endpoints[idx - 1]);
+      SetEndpointIndex(axis, idx - 1);
+      SetEndpointIndex(axis, idx);
+    }
+
+    void SortUp(std::uint32_t axis, std::uint32_t idx) {
+      auto& endpoints = mEndpoints[axis];
+      while (idx + 1 < endpoints.size() && Less(endpoints[idx + 1], endpoints[idx])) SwapUp(axis, idx++);
+    }
+    void SortDown(std::uint32_t axis, std::uint32_t idx) {
+      auto& endpoints = mEndpoints[axis];
+      while (idx > 0 && Less(endpoints[idx], endpoints[idx - 1])) SwapDown(axis, idx--);
+    }
+
+    void MoveEndpoints(Handle handle, const float (&min)[AxisCount], const float (&max)[AxisCount]) {
+      auto& proxy = mProxies[handle];
+      for (std::uint32_t axis = 0; axis < AxisCount; axis++) {
+        const bool min_down = min[axis] < proxy.mMin[axis];
+        const bool max_up   = max[axis] > proxy.mMax[axis];
+
+        proxy.mMin[axis]                             = min[axis];
+        proxy.mMax[axis]                             = max[axis];
+        mEndpoints[axis][proxy.mMinIdx[axis]].mValue = min[axis];
+        mEndpoints[axis][proxy.mMaxIdx[axis]].mValue = max[axis];
+
+        // Growing moves first so new overlaps are found before stale ones are dropped
+        if (min_down) SortDown(axis, proxy.mMinIdx[axis]);
+        if (max_up) SortUp(axis, proxy.mMaxIdx[axis]);
+        if (!min_down) SortUp(axis, proxy.mMinIdx[axis]);
+        if (!max_up) SortDown(axis, proxy.mMaxIdx[axis]);
+      }
+    }
+
+   public:
+    Handle Add(const T& userData, float minX, float minZ, float maxX, float maxZ) {
+      Handle handle;
+      if (!mFreeHandles.empty()) {
+        handle = mFreeHandles.back();
+        mFreeHandles.pop_back();
+      } else {
+        handle = static_cast<Handle>(mProxies.size());
+        mProxies.emplace_back();
+      }
+
+      const float min[AxisCount] = {minX, minZ};
+      const float max[AxisCount] = {maxX, maxZ};
+
+      // Start past every other endpoint, then sink into place; the other axis is tested against final values
+      auto& proxy     = mProxies[handle];
+      proxy.mUserData = userData;
+      proxy.mIsUsed   = true;
+      for (std::uint32_t axis = 0; axis < AxisCount; axis++) {
+        auto& endpoints = mEndpoints[axis];
+
+        proxy.mMin[axis]    = min[axis];
+        proxy.mMax[axis]    = max[axis];
+        proxy.mMinIdx[axis] = static_cast<std::uint32_t>(endpoints.size());
+        proxy.mMaxIdx[axis] = static_cast<std::uint32_t>(endpoints.size() + 1);
+        endpoints.push_back({min[axis], handle << 1});
+        endpoints.push_back({max[axis], (handle << 1) | 1});
+      }
+      for (std::uint32_t axis = 0; axis < AxisCount; axis++) {
+        SortDown(axis, proxy.mMinIdx[axis]);
+        SortDown(axis, proxy.mMaxIdx[axis]);
+      }
+      return handle;
+    }
+
+    void Update(Handle handle, float minX, float minZ, float maxX, float maxZ) {
+      if (!IsValid(handle)) return;
+
+      const float min[AxisCount] = {minX, minZ};
+      const float max[AxisCount] = {maxX, maxZ};
+      MoveEndpoints(handle, min, max);
+    }
+
+    void Remove(Handle handle) {
+      if (!IsValid(handle)) return;
+
+      auto& proxy = mProxies[handle];
+      for (std::uint32_t axis = 0; axis < AxisCount; axis++) {
+        auto& endpoints = mEndpoints[axis];
+        // Max always sits after min, erase it first so the min index stays valid
+        for (std::uint32_t idx : {proxy.mMaxIdx[axis], proxy.mMinIdx[axis]}) {
+          endpoints.erase(endpoints.begin() + idx);
+          for (std::uint32_t i = idx; i < endpoints.size(); i++) SetEndpointIndex(axis, i);
+        }
+      }
+      for (std::size_t i = mPairs.size(); i-- > 0;) {
+        if (mPairs[i].first == handle || mPairs[i].second == handle) RemovePair(mPairs[i].first, mPairs[i].second);
+      }
+      proxy.mIsUsed = false;
+      mFreeHandles.push_back(handle);
+    }
+
+    void Clear() {
+      for (auto& endpoints : mEndpoints) endpoints.clear();
+      mProxies.clear();
+      mFreeHandles.clear();
+      mPairs.clear();
+      mPairIndices.clear();
+    }
+
+    // Seed a proxy from a game grid node; 'GridT' is any Grid<T> (mX/mZ axes with mMin/mMax nodes)
+    template <typename GridT>
+    Handle AddGrid(const T& userData, const GridT& grid) {
+      return Add(userData, grid.mX.mMin.mPosition, grid.mZ.mMin.mPosition, grid.mX.mMax.mPosition,
+                 grid.mZ.mMax.mPosition);
+    }
+    // Refresh a proxy from a game grid node
+    template <typename GridT>
+    void UpdateGrid(Handle handle, const GridT& grid) {
+      Update(handle, grid.mX.mMin.mPosition, grid.mZ.mMin.mPosition, grid.mX.mMax.mPosition, grid.mZ.mMax.mPosition);
+    }
+
+    bool IsValid(Handle handle) const { return handle < mProxies.size() && mProxies[handle].mIsUsed; }
+    const T& GetUserData(Handle handle) const { return mProxies[handle].mUserData; }
+    std::size_t GetProxyCount() const { return mProxies.size() - mFreeHandles.size(); }
+
+    // Every currently overlapping pair, first < second
+    const std::vector<Pair>& GetPairs() const { return mPairs; }
+    bool HasPair(Handle a, Handle b) const { return mPairIndices.count(PairKey(a, b)) != 0; }
+
+    template <typename Fn>
+    void ForEachPair(Fn&& fn) const {
+      for (const auto& pair : mPairs) fn(mProxies[pair.first].mUserData, mProxies[pair.second].mUserData);
+    }
+  };
+}  // namespace SweepAndPrune
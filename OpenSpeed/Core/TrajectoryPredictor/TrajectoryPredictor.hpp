@@ -0,0 +1,322 @@
+// clang-format off
+//
+//    TrajectoryPredictor: Header-only multi-step path prediction for many vehicles, spread over a worker pool. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <algorithm>  // min, max, upper_bound
+#include <cfloat>     // FLT_MAX
+#include <cmath>      // sqrt, sin, cos, abs
+#include <cstddef>    // size_t
+#include <cstdint>    // integer types
+
+#include <OpenSpeed/Core/WorkerPool/WorkerPool.hpp>  // WorkerPool::Pool
+
+namespace TrajectoryPredictor {
+  // Vectors are [x, y, z] with z up, as the games' UMath names them; turning happens on the X/Y plane. Predictions
+  // only read the copies handed to Add()/AddPath(), so they can run on worker threads while the game keeps going.
+
+  enum class Model : std::uint8_t {
+    ConstantVelocity,  // straight line at the current velocity
+    ConstantTurnRate,  // arc at the current speed and yaw rate
+    Path               // along a Path at the current speed, keeping the current offset to its side
+  };
+
+  // A vehicle's state when the prediction starts
+  struct Vehicle {
+    float        mPosition[3];
+    float        mVelocity[3];
+    float        mYawRate;  // angular velocity around the Z axis, radians per second
+    Model        mModel;
+    std::int32_t mPath;  // index from Predictor::AddPath() for Model::Path, -1 without one
+  };
+
+  // Chain of cubic Bezier segments flattened into a polyline with its running length, so points can be found by
+  // distance travelled. Off either end it carries on along the end pieces.
+  class Path {
+   public:
+    static constexpr std::size_t kMaxSegments       = 4;
+    static constexpr std::size_t kSamplesPerSegment = 16;
+    static constexpr std::size_t kMaxPoints         = kMaxSegments * kSamplesPerSegment + 1;
+
+   private:
+    float       mPoints[kMaxPoints][3];
+    float       mDistance[kMaxPoints];
+    std::size_t mCount    = 0;
+    std::size_t mSegments = 0;
+
+    void AddPoint(float x, float y, float z) {
+      if (mCount) {
+        const float dx = x - mPoints[mCount - 1][0], dy = y - mPoints[mCount - 1][1], dz = z - mPoints[mCount - 1][2];
+        const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if (length <= 0.0f) return;
+
+        mDistance[mCount] = mDistance[mCount - 1] + length;
+      } else {
+        mDistance[0] = 0.0f;
+      }
+      mPoints[mCount][0] = x;
+      mPoints[mCount][1] = y;
+      mPoints[mCount][2] = z;
+      mCount++;
+    }
+
+    // Piece 'idx' runs from point idx to idx + 1
+    std::size_t FindPiece(float distance) const {
+      const auto idx = static_cast<std::size_t>(std::upper_bound(mDistance, mDistance + mCount, distance) - mDistance);
+      return std::min(std::max<std::size_t>(idx, 1), mCount - 1) - 1;
+    }
+    // Unit direction of a piece and its left normal on the X/Y plane
+    void GetFrame(std::size_t piece, float (&direction)[3], float (&left)[3]) const {
+      const float length = mDistance[piece + 1] - mDistance[piece];
+      for (std::size_t k = 0; k < 3; k++) direction[k] = (mPoints[piece + 1][k] - mPoints[piece][k]) / length;
+
+      const float flat = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1]);
+      left[0]          = flat > 0.0f ? -direction[1] / flat : 0.0f;
+      left[1]          = flat > 0.0f ? direction[0] / flat : 0.0f;
+      left[2]          = 0.0f;
+    }
+
+   public:
+    void Clear() {
+      mCount    = 0;
+      mSegments = 0;
+    }
+    // Segment from 'p0' to 'p1' with absolute control points 'c0' and 'c1', false once kMaxSegments are added
+    bool AddBezier(const float (&p0)[3], const float (&c0)[3], const float (&c1)[3], const float (&p1)[3]) {
+      if (mSegments == kMaxSegments) return false;
+
+      for (std::size_t i = mCount ? 1 : 0; i <= kSamplesPerSegment; i++) {
+        const float t = static_cast<float>(i) / kSamplesPerSegment, u = 1.0f - t;
+        const float b0 = u * u * u, b1 = 3.0f * u * u * t, b2 = 3.0f * u * t * t, b3 = t * t * t;
+        float       point[3];
+        for (std::size_t k = 0; k < 3; k++) point[k] = b0 * p0[k] + b1 * c0[k] + b2 * c1[k] + b3 * p1[k];
+        AddPoint(point[0], point[1], point[2]);
+      }
+      mSegments++;
+      return true;
+    }
+
+    bool  IsValid() const { return mCount >= 2; }
+    float GetLength() const { return mCount ? mDistance[mCount - 1] : 0.0f; }
+
+    // Distance along the path of the point closest to 'point', its signed offset to the left of the path and the
+    // path's direction there. Needs IsValid().
+    void Project(const float (&point)[3], float& distance, float& lateral, float (&direction)[3]) const {
+      float       bestDistanceSquared = FLT_MAX;
+      std::size_t bestPiece           = 0;
+      for (std::size_t piece = 0; piece + 1 < mCount; piece++) {
+        const float* a      = mPoints[piece];
+        const float* b      = mPoints[piece + 1];
+        const float  length = mDistance[piece + 1] - mDistance[piece];
+
+        float along = 0.0f;
+        for (std::size_t k = 0; k < 3; k++) along += (point[k] - a[k]) * (b[k] - a[k]);
+        along = std::min(std::max(along / length, 0.0f), length);
+
+        float distanceSquared = 0.0f;
+        for (std::size_t k = 0; k < 3; k++) {
+          const float d = point[k] - (a[k] + (b[k] - a[k]) * (along / length));
+          distanceSquared += d * d;
+        }
+        if (distanceSquared < bestDistanceSquared) {
+          bestDistanceSquared = distanceSquared;
+          bestPiece           = piece;
+          distance            = mDistance[piece] + along;
+        }
+      }
+
+      float left[3];
+      GetFrame(bestPiece, direction, left);
+      const float* a = mPoints[bestPiece];
+      lateral        = (point[0] - a[0]) * left[0] + (point[1] - a[1]) * left[1];
+    }
+
+    // Point 'distance' along the path, moved 'lateral' to its left. Needs IsValid().
+    void Sample(float distance, float lateral, float (&out)[3]) const {
+      const auto piece = FindPiece(distance);
+      float      direction[3], left[3];
+      GetFrame(piece, direction, left);
+
+      const float along = distance - mDistance[piece];
+      for (std::size_t k = 0; k < 3; k++) out[k] = mPoints[piece][k] + direction[k] * along + left[k] * lateral;
+    }
+  };
+
+  // Predicts up to MaxSteps points for up to MaxN vehicles. Point 'k' of a vehicle is (k + 1) * stepTime ahead.
+  // Usage: predictor.Clear(); predictor.Add(vehicle); ... predictor.Predict(1.0f / 30.0f, 90, &pool);
+  template <std::size_t MaxN, std::size_t MaxSteps>
+  class Predictor {
+    // Vehicles per pool job; a vehicle takes around a microsecond, so smaller jobs mostly pay for wake-ups
+    static constexpr std::size_t kVehiclesPerJob = 16;
+
+    Vehicle     mVehicles[MaxN];
+    Path        mPaths[MaxN];
+    std::size_t mCount     = 0;
+    std::size_t mPathCount = 0;
+    std::size_t mSteps     = 0;
+    float       mStepTime  = 0.0f;
+
+    alignas(16) float mX[MaxN][MaxSteps];
+    alignas(16) float mY[MaxN][MaxSteps];
+    alignas(16) float mZ[MaxN][MaxSteps];
+
+    void PredictConstantVelocity(std::size_t idx) {
+      const auto& vehicle = mVehicles[idx];
+      for (std::size_t k = 0; k < mSteps; k++) {
+        const float time = static_cast<float>(k + 1) * mStepTime;
+        mX[idx][k]       = vehicle.mPosition[0] + vehicle.mVelocity[0] * time;
+        mY[idx][k]       = vehicle.mPosition[1] + vehicle.mVelocity[1] * time;
+        mZ[idx][k]       = vehicle.mPosition[2] + vehicle.mVelocity[2] * time;
+      }
+    }
+
+    void PredictConstantTurnRate(std::size_t idx) {
+      const auto& vehicle = mVehicles[idx];
+      const float rate    = vehicle.mYawRate;
+      if (std::abs(rate) < 1e-4f) return PredictConstantVelocity(idx);
+
+      // Horizontal velocity turns by 'angle' every step (dv/dt = yaw rate around Z cross v); move by the first step's
+      // chord, then keep rotating it
+      const float angle = rate * mStepTime, c = std::cos(angle), s = std::sin(angle);
+      const float vx = vehicle.mVelocity[0], vy = vehicle.mVelocity[1];
+      float       dx = (vx * s - vy * (1.0f - c)) / rate;
+      float       dy = (vy * s + vx * (1.0f - c)) / rate;
+
+      float x = vehicle.mPosition[0], y = vehicle.mPosition[1];
+      for (std::size_t k = 0; k < mSteps; k++) {
+        x += dx;
+        y += dy;
+        mX[idx][k] = x;
+        mY[idx][k] = y;
+        mZ[idx][k] = vehicle.mPosition[2] + vehicle.mVelocity[2] * static_cast<float>(k + 1) * mStepTime;
+
+        const float rx = dx * c - dy * s;
+        dy             = dx * s + dy * c;
+        dx             = rx;
+      }
+    }
+
+    void PredictPath(std::size_t idx) {
+      const auto& vehicle = mVehicles[idx];
+      if (vehicle.mPath < 0 || !mPaths[vehicle.mPath].IsValid()) return PredictConstantTurnRate(idx);
+
+      const auto& path = mPaths[vehicle.mPath];
+      float       distance = 0.0f, lateral = 0.0f, direction[3];
+      path.Project(vehicle.mPosition, distance, lateral, direction);
+
+      // Signed, so a vehicle going the other way runs the path backwards
+      const float speed = vehicle.mVelocity[0] * direction[0] + vehicle.mVelocity[1] * direction[1] +
+                          vehicle.mVelocity[2] * direction[2];
+      for (std::size_t k = 0; k < mSteps; k++) {
+        float point[3];
+        path.Sample(distance + speed * static_cast<float>(k + 1) * mStepTime, lateral, point);
+        mX[idx][k] = point[0];
+        mY[idx][k] = point[1];
+        mZ[idx][k] = point[2];
+      }
+    }
+
+    void PredictVehicle(std::size_t idx) {
+      switch (mVehicles[idx].mModel) {
+        case Model::ConstantVelocity:
+          return PredictConstantVelocity(idx);
+        case Model::ConstantTurnRate:
+          return PredictConstantTurnRate(idx);
+        case Model::Path:
+          return PredictPath(idx);
+      }
+    }
+
+   public:
+    static constexpr std::size_t kCapacity = MaxN;
+    static constexpr std::size_t kMaxSteps = MaxSteps;
+
+    void Clear() {
+      mCount     = 0;
+      mPathCount = 0;
+      mSteps     = 0;
+    }
+
+    // An empty path for a Model::Path vehicle, nullptr once MaxN paths are taken
+    Path* AddPath(std::int32_t& idx) {
+      if (mPathCount == MaxN) return nullptr;
+
+      idx = static_cast<std::int32_t>(mPathCount);
+      mPaths[mPathCount].Clear();
+      return &mPaths[mPathCount++];
+    }
+    // Returns the vehicle's index, or -1 if the predictor is full
+    std::int32_t Add(const Vehicle& vehicle) {
+      if (mCount == MaxN) return -1;
+
+      mVehicles[mCount] = vehicle;
+      return static_cast<std::int32_t>(mCount++);
+    }
+
+    // Fill 'steps' points (at most MaxSteps) for every vehicle. With a pool, groups of vehicles are predicted in
+    // parallel; without one, or with only a few vehicles, everything runs on the calling thread.
+    void Predict(float stepTime, std::size_t steps, WorkerPool::Pool* pool = nullptr) {
+      mStepTime = stepTime;
+      mSteps    = std::min(steps, MaxSteps);
+
+      if (!pool || mCount <= kVehiclesPerJob) {
+        for (std::size_t idx = 0; idx < mCount; idx++) PredictVehicle(idx);
+        return;
+      }
+      pool->Run((mCount + kVehiclesPerJob - 1) / kVehiclesPerJob, [this](std::size_t job) {
+        const auto end = std::min((job + 1) * kVehiclesPerJob, mCount);
+        for (auto idx = job * kVehiclesPerJob; idx < end; idx++) PredictVehicle(idx);
+      });
+    }
+
+    std::size_t    GetCount() const { return mCount; }
+    std::size_t    GetSteps() const { return mSteps; }
+    float          GetStepTime() const { return mStepTime; }
+    const Vehicle& GetVehicle(std::size_t idx) const { return mVehicles[idx]; }
+
+    // Unchecked, 'idx' must be below GetCount() and 'step' below GetSteps()
+    void GetPoint(std::size_t idx, std::size_t step, float (&out)[3]) const {
+      out[0] = mX[idx][step];
+      out[1] = mY[idx][step];
+      out[2] = mZ[idx][step];
+    }
+
+    // Closest two vehicles get over the prediction, starting positions included. Returns the squared distance
+    // and when it happens in 'time', for collision warnings and intercepts.
+    float FindClosestApproach(std::size_t a, std::size_t b, float& time) const {
+      auto distanceSquared = [](float ax, float ay, float az, float bx, float by, float bz) {
+        const float dx = ax - bx, dy = ay - by, dz = az - bz;
+        return dx * dx + dy * dy + dz * dz;
+      };
+
+      const auto& va   = mVehicles[a].mPosition;
+      const auto& vb   = mVehicles[b].mPosition;
+      float       best = distanceSquared(va[0], va[1], va[2], vb[0], vb[1], vb[2]);
+      time             = 0.0f;
+      for (std::size_t k = 0; k < mSteps; k++) {
+        const float d = distanceSquared(mX[a][k], mY[a][k], mZ[a][k], mX[b][k], mY[b][k], mZ[b][k]);
+        if (d < best) {
+          best = d;
+          time = static_cast<float>(k + 1) * mStepTime;
+        }
+      }
+      return best;
+    }
+  };
+}  // namespace TrajectoryPredictor
@@ -0,0 +1,72 @@
+// clang-format off
+//
+//    TypeTable: A header-only constexpr map from vtable addresses to type bitmasks. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <array>    // array
+#include <cstddef>  // size_t
+#include <cstdint>  // integer types
+
+namespace TypeTable {
+  struct Entry {
+    std::uintptr_t mVtable;
+    std::uint64_t  mMask;
+  };
+
+  // Sorted at compile time; entries sharing a vtable are merged into one mask
+  // Usage: static constexpr TypeTable::Table<2> kTypes({{{0x8AC448, kRigidBody}, {0x8AA6D0, kRigidBody | kRBSmackable}}});
+  template <std::size_t N>
+  class Table {
+    std::array<Entry, N> mEntries{};
+    std::size_t          mSize = 0;
+
+   public:
+    constexpr explicit Table(const std::array<Entry, N>& entries) {
+      for (const auto& entry : entries) {
+        std::size_t idx = 0;
+        while (idx < mSize && mEntries[idx].mVtable < entry.mVtable) idx++;
+
+        if (idx < mSize && mEntries[idx].mVtable == entry.mVtable) {
+          mEntries[idx].mMask |= entry.mMask;
+          continue;
+        }
+        for (std::size_t i = mSize; i > idx; i--) mEntries[i] = mEntries[i - 1];
+        mEntries[idx] = entry;
+        mSize++;
+      }
+    }
+
+    constexpr std::size_t GetSize() const { return mSize; }
+
+    // Every type bit of 'vtable', 0 if unknown
+    constexpr std::uint64_t Find(std::uintptr_t vtable) const {
+      std::size_t first = 0, count = mSize;
+      while (count) {
+        const std::size_t half = count / 2;
+        if (mEntries[first + half].mVtable < vtable) {
+          first += half + 1;
+          count -= half + 1;
+        } else {
+          count = half;
+        }
+      }
+      return first < mSize && mEntries[first].mVtable == vtable ? mEntries[first].mMask : 0;
+    }
+  };
+}  // namespace TypeTable
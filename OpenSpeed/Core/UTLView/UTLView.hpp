@@ -0,0 +1,133 @@
+// clang-format off
+//
+//    UTLView: Header-only typed read-only views of the games' UTL vectors and lists, live or from snapshots. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <algorithm>    // min
+#include <cstddef>      // size_t
+#include <cstdint>      // integer types
+#include <type_traits>  // remove_pointer_t, is_trivially_copyable_v
+#include <vector>       // vector
+
+#include <OpenSpeed/Core/MemorySnapshot/MemorySnapshot.hpp>  // MemorySnapshot::Address, ReadValue
+
+namespace UTLView {
+  using MemorySnapshot::Address;
+
+  // 32-bit layouts of the games' UTL containers (same in MW05 and Carbon)
+  namespace Layout {
+    // UTL::Vector<T>; FixedVector, _Storage and List append their inline space right after it
+    struct Vector {
+      Address       mBegin;
+      std::uint32_t mCapacity;
+      std::uint32_t mSize;
+    };
+    static_assert(sizeof(Vector) == 0xC, "Layout::Vector size mismatch.");
+
+    // Size of a FixedVector/_Storage/List with 'nT' inline slots, which is also a _ListSet bucket's stride
+    constexpr std::uint32_t GetFixedVectorSize(std::uint32_t nT) { return sizeof(Vector) + nT * 4; }
+  }  // namespace Layout
+
+  // Upper bound for any size read from memory, a corrupt vector can't make a view run away
+  static constexpr std::size_t kMaxSize = 0x10000;
+
+  // In-process view over 'size' elements at 'data'
+  template <typename T>
+  class Span {
+    T*          mData = nullptr;
+    std::size_t mSize = 0;
+
+   public:
+    using value_type = T;
+
+    Span() = default;
+    Span(T* data, std::size_t size) : mData(data), mSize(data ? size : 0) {}
+
+    std::size_t size() const { return mSize; }
+    bool        empty() const { return mSize == 0; }
+    T*          data() const { return mData; }
+    T*          begin() const { return mData; }
+    T*          end() const { return mData + mSize; }
+
+    // Unchecked
+    T& operator[](std::size_t idx) const { return mData[idx]; }
+    // nullptr when out of range
+    T* At(std::size_t idx) const { return idx < mSize ? mData + idx : nullptr; }
+  };
+
+  // View of a UTL::Vector-shaped object (Vector, FixedVector, _Storage, List), the size is clamped to the capacity
+  // Usage: for (auto* ivehicle : UTLView::View(aiPursuit->mIVehicleList)) ...
+  template <typename Vector>
+  auto View(Vector& vector) {
+    using T = std::remove_pointer_t<decltype(vector.mBegin)>;
+    const auto size = std::min<std::size_t>({vector.mSize, vector.mCapacity, kMaxSize});
+    return Span<T>(vector.mBegin, size);
+  }
+
+  // View of a UTL::Vector inside a memory source. 'T' is the 32-bit element type, MemorySnapshot::Address for
+  // pointers. Elements are read on demand, or all at once with ReadAll().
+  // Usage: UTLView::SourceVector<Address> list; if (list.Open(snapshot, address)) list.ReadAll(snapshot, out);
+  template <typename T>
+  class SourceVector {
+    static_assert(std::is_trivially_copyable_v<T>, "T must be trivially copyable.");
+
+    Address     mBegin = 0;
+    std::size_t mSize  = 0;
+
+   public:
+    template <typename Source>
+    bool Open(const Source& source, Address vectorAddress) {
+      Layout::Vector vector;
+      if (!MemorySnapshot::ReadValue(source, vectorAddress, vector)) return false;
+
+      mBegin = vector.mBegin;
+      mSize  = mBegin ? std::min<std::size_t>({vector.mSize, vector.mCapacity, kMaxSize}) : 0;
+      return true;
+    }
+
+    std::size_t GetSize() const { return mSize; }
+    Address     GetAddress(std::size_t idx) const { return mBegin + static_cast<Address>(idx * sizeof(T)); }
+
+    // Fails when out of range or unreadable
+    template <typename Source>
+    bool Read(const Source& source, std::size_t idx, T& out) const {
+      return idx < mSize && MemorySnapshot::ReadValue(source, GetAddress(idx), out);
+    }
+    // Unchecked index, the read itself can still fail
+    template <typename Source>
+    bool ReadUnchecked(const Source& source, std::size_t idx, T& out) const {
+      return MemorySnapshot::ReadValue(source, GetAddress(idx), out);
+    }
+    // All elements in one read, appended to 'out'
+    template <typename Source>
+    bool ReadAll(const Source& source, std::vector<T>& out) const {
+      const auto offset = out.size();
+      out.resize(offset + mSize);
+      if (!mSize || source.Read(mBegin, out.data() + offset, mSize * sizeof(T))) return true;
+
+      out.resize(offset);
+      return false;
+    }
+  };
+
+  // Address of bucket 'idx' of a _ListSet<T, nT, E, nE> at 'listSetAddress', to be opened as a SourceVector
+  inline Address GetListSetBucket(Address listSetAddress, std::uint32_t nT, std::uint32_t idx) {
+    return listSetAddress + idx * Layout::GetFixedVectorSize(nT);
+  }
+}  // namespace UTLView
@@ -0,0 +1,637 @@
+// clang-format off
+//
+//    VaultReader: A header-only zero-copy reader for Attrib vault binaries. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <algorithm>      // lower_bound, sort, is_sorted, max
+#include <cstddef>        // size_t
+#include <cstdint>        // integer types
+#include <cstring>        // memchr
+#include <unordered_map>  // unordered_map
+#include <utility>        // move, swap
+#include <vector>         // vector
+
+#if defined(__linux__) || defined(_LINUX)
+#include <fcntl.h>     // open()
+#include <sys/mman.h>  // mmap()
+#include <sys/stat.h>  // fstat()
+#include <unistd.h>    // close()
+#elif defined(_WIN32)
+#include <fileapi.h>    // CreateFileA()
+#include <handleapi.h>  // CloseHandle()
+#include <memoryapi.h>  // CreateFileMappingA(), MapViewOfFile()
+#else
+#error This operating system is not supported.
+#endif
+
+#include <OpenSpeed/Core/AttribReader/AttribReader.hpp>  // AttribReader::Layout, AttribReader::NodeFlags
+#include <OpenSpeed/Core/Hashing/Hashing.hpp>            // Hashing::StringHash32
+
+namespace VaultReader {
+  // Read-only memory mapped file
+  class MappedFile {
+    const std::uint8_t* mData = nullptr;
+    std::size_t         mSize = 0;
+#if defined(_WIN32)
+    HANDLE mFile    = INVALID_HANDLE_VALUE;
+    HANDLE mMapping = nullptr;
+#endif
+
+   public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& rhs) noexcept { *this = std::move(rhs); }
+    MappedFile& operator=(MappedFile&& rhs) noexcept {
+      std::swap(mData, rhs.mData);
+      std::swap(mSize, rhs.mSize);
+#if defined(_WIN32)
+      std::swap(mFile, rhs.mFile);
+      std::swap(mMapping, rhs.mMapping);
+#endif
+      return *this;
+    }
+    ~MappedFile() { Close(); }
+
+    bool Open(const char* path) {
+      Close();
+#if defined(__linux__) || defined(_LINUX)
+      int fd = ::open(path, O_RDONLY);
+      if (fd < 0) return false;
+
+      struct stat st {};
+      if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* data = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+          mData = static_cast<const std::uint8_t*>(data);
+          mSize = static_cast<std::size_t>(st.st_size);
+        }
+      }
+      ::close(fd);
+#elif defined(_WIN32)
+      mFile =
+          ::CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (mFile == INVALID_HANDLE_VALUE) return false;
+
+      LARGE_INTEGER size{};
+      if (::GetFileSizeEx(mFile, &size) && size.QuadPart > 0) {
+        mMapping = ::CreateFileMappingA(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mMapping) {
+          mData = static_cast<const std::uint8_t*>(::MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+          if (mData) mSize = static_cast<std::size_t>(size.QuadPart);
+        }
+      }
+#endif
+      if (!mData) Close();
+      return mData != nullptr;
+    }
+    void Close() {
+#if defined(__linux__) || defined(_LINUX)
+      if (mData) ::munmap(const_cast<std::uint8_t*>(mData), mSize);
+#elif defined(_WIN32)
+      if (mData) ::UnmapViewOfFile(mData);
+      if (mMapping) ::CloseHandle(mMapping);
+      if (mFile != INVALID_HANDLE_VALUE) ::CloseHandle(mFile);
+      mMapping = nullptr;
+      mFile    = INVALID_HANDLE_VALUE;
+#endif
+      mData = nullptr;
+      mSize = 0;
+    }
+
+    const std::uint8_t* GetData() const { return mData; }
+    std::size_t         GetSize() const { return mSize; }
+  };
+
+  struct Span {
+    const std::uint8_t* mData = nullptr;
+    std::size_t         mSize = 0;
+
+    bool Contains(const void* ptr, std::size_t size = 1) const {
+      auto* p = static_cast<const std::uint8_t*>(ptr);
+      return p >= mData && size <= mSize && p <= mData + (mSize - size);
+    }
+    // 'size' bytes at 'offset' past 'ptr', without forming a pointer outside the span
+    bool Contains(const void* ptr, std::uint64_t offset, std::uint64_t size) const {
+      if (!Contains(ptr, 0)) return false;
+
+      const auto left = static_cast<std::uint64_t>(mData + mSize - static_cast<const std::uint8_t*>(ptr));
+      return offset <= left && size <= left - offset;
+    }
+  };
+
+  // Chunk ids as read little-endian from their 4 characters
+  constexpr std::uint32_t FourCC(const char (&id)[5]) {
+    return static_cast<std::uint8_t>(id[0]) | static_cast<std::uint8_t>(id[1]) << 8 |
+           static_cast<std::uint8_t>(id[2]) << 16 | static_cast<std::uint32_t>(static_cast<std::uint8_t>(id[3])) << 24;
+  }
+  namespace ChunkId {
+    static constexpr std::uint32_t Version      = FourCC("Vers");
+    static constexpr std::uint32_t Dependencies = FourCC("DepN");
+    static constexpr std::uint32_t Strings      = FourCC("StrN");
+    static constexpr std::uint32_t Data         = FourCC("DatN");
+    static constexpr std::uint32_t Exports      = FourCC("ExpN");
+    static constexpr std::uint32_t Pointers     = FourCC("PtrN");
+  }  // namespace ChunkId
+
+  // Export type ids, hashed the same way as Attrib keys
+  namespace ExportType {
+    static constexpr std::uint32_t Class      = Hashing::StringHash32("Attrib::Class");
+    static constexpr std::uint32_t Collection = Hashing::StringHash32("Attrib::Collection");
+    static constexpr std::uint32_t Database   = Hashing::StringHash32("Attrib::Database");
+  }  // namespace ExportType
+
+  // On-disk layouts, little-endian with 32-bit pointers that the PtrN chunk fixes up
+  namespace Layout {
+    using AttribReader::Layout::Array;
+    using AttribReader::Layout::Node;
+
+    // Attrib::ChunkBlock; mSize includes the header
+    struct ChunkBlock {
+      std::uint32_t mType;
+      std::uint32_t mSize;
+    };
+    struct ExportEntry {
+      std::uint32_t mId;
+      std::uint32_t mType;
+      std::uint32_t mSize;
+      std::uint32_t mOffset;  // into the DatN payload
+    };
+    struct PointerEntry {
+      enum Type : std::uint16_t { Null, Internal, Dependency };
+
+      std::uint32_t mFixupOffset;  // of the pointer field, into the DatN payload
+      Type          mType;
+      std::uint16_t mIndex;        // dependency index for Type::Dependency
+      std::uint32_t mDestination;  // offset into the DatN payload or the dependency
+    };
+    // Attrib::Definition
+    struct Definition {
+      enum Flags : std::uint8_t { Array = 1 << 0, InLayout = 1 << 1, IsBound = 1 << 2, IsNotSearchable = 1 << 3 };
+
+      std::uint32_t mKey;
+      std::uint32_t mType;
+      std::uint16_t mOffset;
+      std::uint16_t mSize;
+      std::uint16_t mMaxCount;
+      std::uint8_t  mFlags;
+      std::uint8_t  mAlignment;
+    };
+    // Attrib::Private, header of an array stored in a layout
+    struct Private {
+      std::uint16_t mCapacity;
+      std::uint16_t mCount;
+      std::uint16_t mElemSize;
+      std::uint16_t mData;
+    };
+    struct ClassLoadData {
+      std::uint32_t mKey;
+      std::uint32_t mNumDefinitions;
+      std::uint32_t mDefinitions;  // pointer
+      std::uint32_t mNumCollections;
+      std::uint32_t mLayoutSize;
+    };
+    // Followed by mNumEntries Node entries
+    struct CollectionLoadData {
+      std::uint32_t mKey;
+      std::uint32_t mClass;
+      std::uint32_t mParent;
+      std::uint32_t mTableReserve;
+      std::uint32_t mTableKeyShift;
+      std::uint32_t mNumEntries;
+      std::uint16_t mNumTypes;
+      std::uint16_t mTypesLen;
+      std::uint32_t mLayout;  // pointer
+      std::uint32_t mTypes;   // pointer to mNumTypes type keys
+    };
+
+    static_assert(sizeof(ExportEntry) == 0x10, "Layout::ExportEntry size mismatch.");
+    static_assert(sizeof(PointerEntry) == 0xC, "Layout::PointerEntry size mismatch.");
+    static_assert(sizeof(Definition) == 0x10, "Layout::Definition size mismatch.");
+    static_assert(sizeof(CollectionLoadData) == 0x24, "Layout::CollectionLoadData size mismatch.");
+  }  // namespace Layout
+
+  // Walk the chunks of a span in place, fn(const Layout::ChunkBlock& chunk, Span payload)
+  template <typename Fn>
+  void ForEachChunk(Span span, Fn&& fn) {
+    std::size_t offset = 0;
+    while (span.mSize - offset >= sizeof(Layout::ChunkBlock)) {
+      auto* chunk = reinterpret_cast<const Layout::ChunkBlock*>(span.mData + offset);
+      if (chunk->mSize < sizeof(Layout::ChunkBlock) || chunk->mSize > span.mSize - offset) break;
+
+      fn(*chunk, Span{span.mData + offset + sizeof(Layout::ChunkBlock), chunk->mSize - sizeof(Layout::ChunkBlock)});
+      offset += chunk->mSize;
+    }
+  }
+
+  // A single .vlt and its dependencies, all referenced in place
+  class Vault {
+    Span                        mData;
+    Span                        mStrings;
+    std::vector<Span>           mDependencies;
+    const std::uint32_t*        mDepKeys      = nullptr;
+    const std::uint32_t*        mDepNames     = nullptr;
+    Span                        mDepNameTable;
+    std::uint32_t               mNumDeps      = 0;
+    const Layout::ExportEntry*  mExports      = nullptr;
+    std::uint32_t               mNumExports   = 0;
+    const Layout::PointerEntry* mPointers     = nullptr;
+    std::uint32_t               mNumPointers  = 0;
+    std::uint32_t               mVersion      = 0;
+    std::vector<std::uint32_t>  mPointerOrder;  // only when PtrN isn't sorted by fixup offset
+
+    template <typename T>
+    static const T* As(Span span, std::size_t offset = 0, std::size_t count = 1) {
+      if (offset > span.mSize || count > (span.mSize - offset) / sizeof(T)) return nullptr;
+      return reinterpret_cast<const T*>(span.mData + offset);
+    }
+
+    const Layout::PointerEntry* FindPointer(std::uint32_t fixupOffset) const {
+      auto less = [](const Layout::PointerEntry& entry, std::uint32_t offset) { return entry.mFixupOffset < offset; };
+      if (mPointerOrder.empty()) {
+        auto* it = std::lower_bound(mPointers, mPointers + mNumPointers, fixupOffset, less);
+        return (it != mPointers + mNumPointers && it->mFixupOffset == fixupOffset) ? it : nullptr;
+      }
+
+      auto it = std::lower_bound(
+          mPointerOrder.begin(), mPointerOrder.end(), fixupOffset,
+          [this, &less](std::uint32_t idx, std::uint32_t offset) { return less(mPointers[idx], offset); });
+      return (it != mPointerOrder.end() && mPointers[*it].mFixupOffset == fixupOffset) ? &mPointers[*it] : nullptr;
+    }
+
+   public:
+    // 'dependencies' are the .bin files DepN lists, in the same order
+    bool Load(Span vault, std::vector<Span> dependencies = {}) {
+      *this         = Vault{};
+      mDependencies = std::move(dependencies);
+
+      ForEachChunk(vault, [this](const Layout::ChunkBlock& chunk, Span payload) {
+        switch (chunk.mType) {
+          case ChunkId::Version:
+            if (auto* version = As<std::uint32_t>(payload)) mVersion = *version;
+            break;
+          case ChunkId::Dependencies:
+            // count, keys[count], name offsets[count], name table
+            if (auto* count = As<std::uint32_t>(payload)) {
+              mDepKeys  = As<std::uint32_t>(payload, 4, *count);
+              mDepNames = As<std::uint32_t>(payload, 4 + *count * 4, *count);
+              if (mDepKeys && mDepNames) {
+                mNumDeps      = *count;
+                mDepNameTable = {payload.mData + 4 + *count * 8, payload.mSize - 4 - *count * 8};
+              }
+            }
+            break;
+          case ChunkId::Strings: mStrings = payload; break;
+          case ChunkId::Data: mData = payload; break;
+          case ChunkId::Exports:
+            if (auto* count = As<std::uint32_t>(payload)) {
+              mExports = As<Layout::ExportEntry>(payload, 4, *count);
+              if (mExports) mNumExports = *count;
+            }
+            break;
+          case ChunkId::Pointers:
+            mNumPointers = static_cast<std::uint32_t>(payload.mSize / sizeof(Layout::PointerEntry));
+            mPointers    = As<Layout::PointerEntry>(payload, 0, mNumPointers);
+            break;
+          default: break;
+        }
+      });
+      if (!mData.mData) return false;
+
+      // Fixups are usually emitted in order, only index them when they're not
+      auto byOffset = [this](std::uint32_t lhs, std::uint32_t rhs) {
+        return mPointers[lhs].mFixupOffset < mPointers[rhs].mFixupOffset;
+      };
+      bool isSorted = std::is_sorted(mPointers, mPointers + mNumPointers,
+                                     [](const Layout::PointerEntry& lhs, const Layout::PointerEntry& rhs) {
+                                       return lhs.mFixupOffset < rhs.mFixupOffset;
+                                     });
+      if (!isSorted) {
+        mPointerOrder.resize(mNumPointers);
+        for (std::uint32_t i = 0; i < mNumPointers; i++) mPointerOrder[i] = i;
+        std::sort(mPointerOrder.begin(), mPointerOrder.end(), byOffset);
+      }
+      return true;
+    }
+
+    // Resolve a pointer field inside the DatN payload through the relocation table, nullptr if it isn't fixed up
+    const std::uint8_t* Resolve(const void* field) const {
+      if (!mData.Contains(field, sizeof(std::uint32_t))) return nullptr;
+
+      auto  fixupOffset = static_cast<std::uint32_t>(static_cast<const std::uint8_t*>(field) - mData.mData);
+      auto* pointer     = FindPointer(fixupOffset);
+      if (!pointer) return nullptr;
+
+      switch (pointer->mType) {
+        case Layout::PointerEntry::Internal:
+          return pointer->mDestination < mData.mSize ? mData.mData + pointer->mDestination : nullptr;
+        case Layout::PointerEntry::Dependency:
+          if (pointer->mIndex >= mDependencies.size()) return nullptr;
+          if (pointer->mDestination >= mDependencies[pointer->mIndex].mSize) return nullptr;
+          return mDependencies[pointer->mIndex].mData + pointer->mDestination;
+        default: return nullptr;
+      }
+    }
+    template <typename T>
+    const T* Resolve(const void* field) const {
+      return reinterpret_cast<const T*>(Resolve(field));
+    }
+
+    std::uint32_t GetVersion() const { return mVersion; }
+    Span          GetData() const { return mData; }
+    Span          GetStrings() const { return mStrings; }
+
+    std::uint32_t GetNumDependencies() const { return mNumDeps; }
+    std::uint32_t GetDependencyKey(std::uint32_t idx) const { return idx < mNumDeps ? mDepKeys[idx] : 0; }
+    // nullptr if the name isn't a terminated string inside the DepN chunk
+    const char* GetDependencyName(std::uint32_t idx) const {
+      if (idx >= mNumDeps || mDepNames[idx] >= mDepNameTable.mSize) return nullptr;
+
+      auto* name = mDepNameTable.mData + mDepNames[idx];
+      return std::memchr(name, 0, mDepNameTable.mSize - mDepNames[idx]) ? reinterpret_cast<const char*>(name) : nullptr;
+    }
+
+    // Whether 'size' bytes at 'offset' past 'ptr' lie in DatN or a single dependency, the spans Resolve() returns into
+    bool Contains(const void* ptr, std::uint64_t offset, std::uint64_t size) const {
+      if (mData.Contains(ptr, 0)) return mData.Contains(ptr, offset, size);
+      for (const auto& dependency : mDependencies)
+        if (dependency.Contains(ptr, 0)) return dependency.Contains(ptr, offset, size);
+      return false;
+    }
+
+    std::uint32_t              GetNumExports() const { return mNumExports; }
+    const Layout::ExportEntry& GetExport(std::uint32_t idx) const { return mExports[idx]; }
+    // Exported object, nullptr if it doesn't fit the DatN payload
+    template <typename T>
+    const T* GetExportData(const Layout::ExportEntry& entry) const {
+      if (entry.mSize < sizeof(T)) return nullptr;
+      return As<T>(mData, entry.mOffset) && As<std::uint8_t>(mData, entry.mOffset, entry.mSize)
+                 ? reinterpret_cast<const T*>(mData.mData + entry.mOffset)
+                 : nullptr;
+    }
+  };
+
+  class Database;
+
+  // Mirrors Attrib::Collection
+  class Collection {
+    friend class Database;
+
+    const Database*                   mDatabase = nullptr;
+    const Vault*                      mVault    = nullptr;
+    const Layout::CollectionLoadData* mData     = nullptr;
+
+    const Layout::Node* GetEntries() const { return reinterpret_cast<const Layout::Node*>(mData + 1); }
+
+    // Item 'idx' of attribute 'key' in this collection only
+    const std::uint8_t* GetOwnData(std::uint32_t key, std::uint32_t idx, std::uint32_t* outCount) const;
+
+   public:
+    Collection() = default;
+    Collection(const Database* database, const Vault* vault, const Layout::CollectionLoadData* data)
+        : mDatabase(database), mVault(vault), mData(data) {}
+
+    bool          IsValid() const { return mData != nullptr; }
+    std::uint32_t GetKey() const { return mData->mKey; }
+    std::uint32_t GetClassKey() const { return mData->mClass; }
+    std::uint32_t GetParentKey() const { return mData->mParent; }
+    const Vault&  GetVault() const { return *mVault; }
+    Collection    GetParent() const;
+
+    // Layout blob, nullptr if the class has none
+    const std::uint8_t* GetLayout() const { return mVault->Resolve(&mData->mLayout); }
+
+    // Mirrors Collection::GetData; walks the parent chain
+    template <typename T>
+    const T* GetData(std::uint32_t key, std::uint32_t idx = 0) const {
+      return reinterpret_cast<const T*>(GetDataPtr(key, idx));
+    }
+    const std::uint8_t* GetDataPtr(std::uint32_t key, std::uint32_t idx = 0) const;
+    std::uint32_t       GetCount(std::uint32_t key) const;
+    // A char* field from GetData(), resolved through the vault of the collection in the parent chain holding it;
+    // an inherited field can live in another vault than this collection
+    const char* ResolveString(const std::uint8_t* field) const;
+  };
+
+  // Mirrors Attrib::Class
+  class Class {
+    friend class Database;
+
+    const Vault*                                  mVault       = nullptr;
+    const Layout::ClassLoadData*                  mData        = nullptr;
+    const Layout::Definition*                     mDefinitions = nullptr;
+    std::vector<std::uint32_t>                    mDefinitionKeys;  // sorted
+    std::vector<std::uint32_t>                    mCollectionKeys;  // sorted
+    std::unordered_map<std::uint32_t, Collection> mCollections;
+
+    static std::uint32_t GetNext(const std::vector<std::uint32_t>& keys, std::uint32_t key) {
+      auto it = std::upper_bound(keys.begin(), keys.end(), key);
+      return it != keys.end() ? *it : 0;
+    }
+
+   public:
+    std::uint32_t GetKey() const { return mData->mKey; }
+    std::uint32_t GetLayoutSize() const { return mData->mLayoutSize; }
+
+    const Layout::Definition* GetDefinition(std::uint32_t key) const {
+      for (std::uint32_t i = 0; mDefinitions && i < mData->mNumDefinitions; i++)
+        if (mDefinitions[i].mKey == key) return &mDefinitions[i];
+      return nullptr;
+    }
+    std::uint32_t GetNumDefinitions() const { return static_cast<std::uint32_t>(mDefinitionKeys.size()); }
+    std::uint32_t GetFirstDefinition() const { return mDefinitionKeys.empty() ? 0 : mDefinitionKeys.front(); }
+    std::uint32_t GetNextDefinition(std::uint32_t key) const { return GetNext(mDefinitionKeys, key); }
+
+    Collection GetCollection(std::uint32_t key) const {
+      auto it = mCollections.find(key);
+      return it != mCollections.end() ? it->second : Collection{};
+    }
+    std::uint32_t GetNumCollections() const { return static_cast<std::uint32_t>(mCollectionKeys.size()); }
+    std::uint32_t GetFirstCollection() const { return mCollectionKeys.empty() ? 0 : mCollectionKeys.front(); }
+    std::uint32_t GetNextCollection(std::uint32_t key) const { return GetNext(mCollectionKeys, key); }
+  };
+
+  // Mirrors Attrib::Database over any number of loaded vaults; indexes exports, never copies them
+  class Database {
+    std::unordered_map<std::uint32_t, Class> mClasses;
+
+   public:
+    Database() = default;
+    Database(const Database&) = delete;
+    Database& operator=(const Database&) = delete;
+
+    // Vault must outlive the database; classes must be added before or with their collections
+    void AddVault(const Vault& vault) {
+      for (std::uint32_t i = 0; i < vault.GetNumExports(); i++) {
+        const auto& entry = vault.GetExport(i);
+        if (entry.mType != ExportType::Class) continue;
+
+        auto* data = vault.GetExportData<Layout::ClassLoadData>(entry);
+        if (!data) continue;
+
+        auto& cls        = mClasses[data->mKey];
+        cls.mVault       = &vault;
+        cls.mData        = data;
+        cls.mDefinitions = vault.Resolve<Layout::Definition>(&data->mDefinitions);
+        cls.mDefinitionKeys.clear();
+        for (std::uint32_t d = 0; cls.mDefinitions && d < data->mNumDefinitions; d++) {
+          if (!vault.GetData().Contains(&cls.mDefinitions[d], sizeof(Layout::Definition))) break;
+          cls.mDefinitionKeys.push_back(cls.mDefinitions[d].mKey);
+        }
+        std::sort(cls.mDefinitionKeys.begin(), cls.mDefinitionKeys.end());
+      }
+
+      for (std::uint32_t i = 0; i < vault.GetNumExports(); i++) {
+        const auto& entry = vault.GetExport(i);
+        if (entry.mType != ExportType::Collection) continue;
+
+        auto* data = vault.GetExportData<Layout::CollectionLoadData>(entry);
+        if (!data || sizeof(*data) + std::uint64_t(data->mNumEntries) * sizeof(Layout::Node) > entry.mSize) continue;
+
+        auto it = mClasses.find(data->mClass);
+        if (it == mClasses.end()) continue;
+
+        auto& cls = it->second;
+        if (!cls.mCollections.count(data->mKey)) {
+          cls.mCollectionKeys.insert(
+              std::upper_bound(cls.mCollectionKeys.begin(), cls.mCollectionKeys.end(), data->mKey), data->mKey);
+        }
+        cls.mCollections[data->mKey] = Collection(this, &vault, data);
+      }
+    }
+
+    const Class* GetClass(std::uint32_t key) const {
+      auto it = mClasses.find(key);
+      return it != mClasses.end() ? &it->second : nullptr;
+    }
+    Collection FindCollection(std::uint32_t classKey, std::uint32_t collectionKey) const {
+      auto* cls = GetClass(classKey);
+      return cls ? cls->GetCollection(collectionKey) : Collection{};
+    }
+
+    // Run a function on all classes, fn(const Class& cls)
+    template <typename Fn>
+    void ForEachClass(Fn&& fn) const {
+      for (const auto& [key, cls] : mClasses) fn(cls);
+    }
+  };
+
+  inline Collection Collection::GetParent() const {
+    if (!mData || !mData->mParent) return {};
+    return mDatabase->FindCollection(mData->mClass, mData->mParent);
+  }
+
+  inline const std::uint8_t* Collection::GetOwnData(std::uint32_t key, std::uint32_t idx,
+                                                    std::uint32_t* outCount) const {
+    using namespace AttribReader;
+
+    // Every read is checked against the span it lands in, a malformed vault gives nullptr instead
+    auto* cls      = mDatabase->GetClass(mData->mClass);
+    auto* def      = cls ? cls->GetDefinition(key) : nullptr;
+    auto  elemSize = def ? std::max<std::uint32_t>(def->mSize, 1) : 1;
+
+    // Entries that aren't laid out
+    const auto* entries = GetEntries();
+    for (std::uint32_t i = 0; i < mData->mNumEntries; i++) {
+      const auto& entry = entries[i];
+      if (entry.mKey != key) continue;
+
+      if (entry.mFlags & IsArray) {
+        auto* array = mVault->Resolve<Layout::Array>(&entry.mPtr);
+        if (!array || !mVault->Contains(array, 0, sizeof(Layout::Array))) return nullptr;
+        if (outCount) *outCount = array->mCount;
+        if (idx >= array->mCount) return nullptr;
+
+        const std::uint64_t size   = array->mSize ? array->mSize : sizeof(std::uint32_t);
+        const std::uint64_t offset = sizeof(Layout::Array) + array->GetPad() + idx * size;
+        if (!mVault->Contains(array, offset, size)) return nullptr;
+
+        auto* item = reinterpret_cast<const std::uint8_t*>(array) + offset;
+        if (array->mSize) return item;
+
+        auto* data = mVault->Resolve(item);
+        return data && mVault->Contains(data, 0, elemSize) ? data : nullptr;
+      }
+
+      if (outCount) *outCount = 1;
+      if (idx) return nullptr;
+      if (entry.mFlags & IsByValue) return reinterpret_cast<const std::uint8_t*>(&entry.mPtr);
+
+      auto* data = mVault->Resolve(&entry.mPtr);
+      return data && mVault->Contains(data, 0, elemSize) ? data : nullptr;
+    }
+
+    // Laid out attributes live at the definition's offset, inside the class' layout size
+    auto* layout = GetLayout();
+    if (!def || !(def->mFlags & Layout::Definition::InLayout) || !layout) return nullptr;
+
+    const std::uint64_t layoutSize = cls->GetLayoutSize();
+    if (!mVault->Contains(layout, 0, layoutSize)) return nullptr;
+
+    if (def->mFlags & Layout::Definition::Array) {
+      if (std::uint64_t(def->mOffset) + sizeof(Layout::Private) > layoutSize) return nullptr;
+
+      auto* header = reinterpret_cast<const Layout::Private*>(layout + def->mOffset);
+      if (outCount) *outCount = header->mCount;
+      if (idx >= header->mCount) return nullptr;
+
+      const std::uint64_t offset = def->mOffset + sizeof(Layout::Private) + std::uint64_t(idx) * def->mSize;
+      return offset + def->mSize <= layoutSize ? layout + offset : nullptr;
+    }
+
+    if (outCount) *outCount = 1;
+    if (idx || std::uint64_t(def->mOffset) + def->mSize > layoutSize) return nullptr;
+    return layout + def->mOffset;
+  }
+
+  inline const std::uint8_t* Collection::GetDataPtr(std::uint32_t key, std::uint32_t idx) const {
+    Collection collection = *this;
+    for (std::uint32_t depth = 0; collection.IsValid() && depth < AttribReader::kMaxParentDepth; depth++) {
+      std::uint32_t count = 0;
+      auto*         data  = collection.GetOwnData(key, idx, &count);
+      if (data || count) return data;
+
+      collection = collection.GetParent();
+    }
+    return nullptr;
+  }
+
+  inline const char* Collection::ResolveString(const std::uint8_t* field) const {
+    Collection collection = *this;
+    for (std::uint32_t depth = 0; collection.IsValid() && depth < AttribReader::kMaxParentDepth; depth++) {
+      if (collection.mVault->GetData().Contains(field, sizeof(std::uint32_t)))
+        return collection.mVault->Resolve<char>(field);
+
+      collection = collection.GetParent();
+    }
+    return nullptr;
+  }
+
+  inline std::uint32_t Collection::GetCount(std::uint32_t key) const {
+    Collection collection = *this;
+    for (std::uint32_t depth = 0; collection.IsValid() && depth < AttribReader::kMaxParentDepth; depth++) {
+      std::uint32_t count = 0;
+      collection.GetOwnData(key, 0, &count);
+      if (count) return count;
+
+      collection = collection.GetParent();
+    }
+    return 0;
+  }
+}  // namespace VaultReader
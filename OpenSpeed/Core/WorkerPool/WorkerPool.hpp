@@ -0,0 +1,125 @@
+// clang-format off
+//
+//    WorkerPool: A header-only pool of persistent worker threads for short, frame-sized parallel loops. (C++17)
+//    Copyright (C) 2022 Berkay Yigit <berkaytgy@gmail.com>
+//
+//    This program is free software: you can redistribute it and/or modify
+//    it under the terms of the GNU Affero General Public License as published
+//    by the Free Software Foundation, either version 3 of the License, or
+//    (at your option) any later version.
+//
+//    This program is distributed in the hope that it will be useful,
+//    but WITHOUT ANY WARRANTY; without even the implied warranty of
+//    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+//    GNU Affero General Public License for more details.
+//
+//    You should have received a copy of the GNU Affero General Public License
+//    along with this program. If not, see <https://www.gnu.org/licenses/>.
+//
+// clang-format on
+
+#pragma once
+#include <algorithm>           // max
+#include <atomic>              // atomic
+#include <condition_variable>  // condition_variable
+#include <cstddef>             // size_t
+#include <cstdint>             // integer types
+#include <mutex>               // mutex, unique_lock, scoped_lock
+#include <thread>              // thread
+#include <type_traits>         // remove_reference_t
+#include <vector>              // vector
+
+namespace WorkerPool {
+  // Threads are started once and sleep between loops, so a loop costs a wake-up instead of a thread spawn.
+  // Run() is meant to be called from one thread at a time (e.g. the game thread once per frame); the caller works
+  // on the loop too and Run() returns once every index is done.
+  // Usage: WorkerPool::Pool pool; pool.Run(count, [&](std::size_t idx) { ... });
+  class Pool {
+    using Job = void (*)(const void* context, std::size_t idx);
+
+    std::vector<std::thread> mThreads;
+    std::mutex               mMutex;
+    std::condition_variable  mWake;
+    std::condition_variable  mDone;
+    std::uint64_t            mGeneration = 0;
+    std::size_t              mBusy       = 0;
+    bool                     mIsStopping = false;
+
+    // The current loop, only written while every worker is idle
+    Job                      mFn      = nullptr;
+    const void*              mContext = nullptr;
+    std::size_t              mCount   = 0;
+    std::atomic<std::size_t> mNext{0};
+
+    void Work() {
+      for (std::size_t idx; (idx = mNext.fetch_add(1, std::memory_order_relaxed)) < mCount;) mFn(mContext, idx);
+    }
+
+    void WorkerLoop() {
+      std::uint64_t generation = 0;
+      for (;;) {
+        {
+          std::unique_lock lock(mMutex);
+          mWake.wait(lock, [&] { return mIsStopping || mGeneration != generation; });
+          if (mIsStopping) return;
+
+          generation = mGeneration;
+        }
+
+        Work();
+
+        std::scoped_lock lock(mMutex);
+        if (--mBusy == 0) mDone.notify_one();
+      }
+    }
+
+   public:
+    // 0 picks one less than the hardware thread count, as the calling thread works too
+    explicit Pool(std::uint32_t threadCount = 0) {
+      if (!threadCount) threadCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+      for (std::uint32_t i = 0; i < threadCount; i++) mThreads.emplace_back([this] { WorkerLoop(); });
+    }
+    ~Pool() {
+      {
+        std::scoped_lock lock(mMutex);
+        mIsStopping = true;
+      }
+      mWake.notify_all();
+      for (auto& thread : mThreads) thread.join();
+    }
+    Pool(const Pool&)            = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    // Worker threads, not counting the caller
+    std::size_t GetThreadCount() const { return mThreads.size(); }
+
+    // fn(std::size_t idx) for every idx in [0, count), in no particular order or thread
+    template <typename Fn>
+    void Run(std::size_t count, Fn&& fn) {
+      if (count == 0) return;
+      if (count == 1 || mThreads.empty()) {
+        for (std::size_t idx = 0; idx < count; idx++) fn(idx);
+        return;
+      }
+
+      using Context = std::remove_reference_t<Fn>;
+      {
+        std::scoped_lock lock(mMutex);
+        mFn      = [](const void* context, std::size_t idx) {
+          (*const_cast<Context*>(static_cast<const Context*>(context)))(idx);
+        };
+        mContext = &fn;
+        mCount   = count;
+        mNext.store(0, std::memory_order_relaxed);
+        mBusy = mThreads.size();
+        mGeneration++;
+      }
+      mWake.notify_all();
+
+      Work();
+
+      std::unique_lock lock(mMutex);
+      mDone.wait(lock, [this] { return mBusy == 0; });
+    }
+  };
+}  // namespace WorkerPool
@@ -18,9 +18,16 @@
 // clang-format on
 
 #pragma once
-#include <functional>  // std::function
+#include <vector>  // vector
 
-#include <OpenSpeed/Core/MemoryEditor/MemoryEditor.hpp>  // ValidateMemoryIsInitialized
+#include <OpenSpeed/Core/ArenaAllocator/ArenaAllocator.hpp>  // ArenaAllocator::FrameArena
+#include <OpenSpeed/Core/EASTL/EASTL/vector.h>               // eastl::vector
+#include <OpenSpeed/Core/InstanceRange/InstanceRange.hpp>    // InstanceRange::Range, ForEach
+#include <OpenSpeed/Core/InstanceTable/InstanceTable.hpp>    // InstanceTable::ListTable
+#include <OpenSpeed/Core/IntrusiveList/IntrusiveList.hpp>    // IntrusiveList::Range
+#include <OpenSpeed/Core/MemoryEditor/MemoryEditor.hpp>      // ValidateMemoryIsInitialized
+#include <OpenSpeed/Core/SpatialHash/SpatialHash.hpp>        // SpatialHash::HashGrid
+#include <OpenSpeed/Core/TypeTable/TypeTable.hpp>            // TypeTable::Table
 
 #include <OpenSpeed/Game.Carbon/Types.h>
 #include <OpenSpeed/Game.Carbon/Types/AIVehicleCopCar.h>   // AIVehicleCopCar, AIVehiclePursuit, AIVehiclePid, AIVehicle
@@ -34,6 +41,119 @@
 #include <OpenSpeed/Game.Carbon/Types/IRigidBody.h>        // IRigidBody
 
 namespace OpenSpeed::Carbon {
+  //           //
+  // Type info //
+  //           //
+
+  namespace TypeInfoEx {
+    // One bit per verified cast; a vtable's mask has the bit of every cast that accepts it
+    enum TypeBits : std::uint64_t {
+      kAIVehicle        = 1ull << 0,
+      kAIVehicleCopCar  = 1ull << 1,
+      kAIVehicleEmpty   = 1ull << 2,
+      kAIVehicleGhost   = 1ull << 3,
+      kAIVehicleHuman   = 1ull << 4,
+      kAIVehiclePid     = 1ull << 5,
+      kAIVehiclePursuit = 1ull << 6,
+      kAIVehicleRacecar = 1ull << 7,
+      kAIVehicleTraffic = 1ull << 8,
+      kIInput           = 1ull << 9,
+      kIInputPlayer     = 1ull << 10,
+    };
+
+    static constexpr TypeTable::Table<19> kTypeTable({{
+        {0x9C3BF8, kIInput},            // AIVehicle (IInput)
+        {0x9C3D80, kAIVehicle},         // AIVehicle
+        {0x9C3DE8, kIInput},            // AIVehiclePid (IInput)
+        {0x9C3F70, kAIVehiclePid},      // AIVehiclePid
+        {0x9C4170, kAIVehicleTraffic},  // AIVehicleTraffic
+        {0x9C41D8, kIInput},            // AIVehiclePursuit (IInput)
+        {0x9C4360, kAIVehiclePursuit},  // AIVehiclePursuit
+        {0x9C4458, kIInput},            // AIVehicleGhost (IInput)
+        {0x9C45E0, kAIVehicleGhost},    // AIVehicleGhost
+        {0x9C4648, kIInput},            // AIVehicleEmpty (IInput)
+        {0x9C47D0, kAIVehicleEmpty},    // AIVehicleEmpty
+        {0x9C48B8, kIInput},            // AIVehicleCopCar (IInput)
+        {0x9C4A40, kAIVehicleCopCar},   // AIVehicleCopCar
+        {0x9C4B48, kIInput},            // AIPerpVehicle (IInput)
+        {0x9C4DD0, kIInput},            // AIVehicleRaceCar (IInput)
+        {0x9C4F58, kAIVehicleRacecar},  // AIVehicleRacecar
+        {0x9C4FF0, kIInputPlayer},      // IInputPlayer
+        {0x9C50D8, kIInput},            // AIVehicleHuman (IInput)
+        {0x9C5260, kAIVehicleHuman},    // AIVehicleHuman
+    }});
+
+    // Type bits of an object from its vtable, 0 if its memory is bad or the type is unknown; one lookup answers
+    // every cast at once
+    // Usage: auto mask = TypeInfoEx::GetTypeMask(iAI); if (mask & TypeInfoEx::kAIVehicleCopCar) ...
+    template <typename T>
+    static std::uint64_t GetTypeMask(T* object) {
+      if (!object || !MemoryEditor::Get().ValidateMemoryIsInitialized(object)) return 0;
+      return kTypeTable.Find(*reinterpret_cast<const std::uintptr_t*>(object));
+    }
+    template <typename T>
+    static bool Is(T* object, std::uint64_t bits) {
+      return (GetTypeMask(object) & bits) != 0;
+    }
+  }  // namespace TypeInfoEx
+
+  //       //
+  // Frame //
+  //       //
+
+  namespace FrameEx {
+    static inline std::uint32_t g_mFrame = 0;
+
+    // Advance the counter per-frame caches are keyed on. Nothing in here hooks the main loop, so the mod has to call
+    // it once per frame from its own hook.
+    static void          NextFrame() { g_mFrame++; }
+    static std::uint32_t GetFrame() { return g_mFrame; }
+  }  // namespace FrameEx
+
+  //            //
+  // FrameArena //
+  //            //
+
+  namespace FrameArenaEx {
+    static inline ArenaAllocator::FrameArena g_mFrameArena{256 * 1024};
+
+    // Scratch memory for per-frame analysis, emptied the first time it is used after FrameEx::NextFrame(). Without
+    // those calls it is never emptied and keeps growing, call Reset() instead then. Game thread only, and nothing
+    // allocated from it may be kept into the next frame.
+    static ArenaAllocator::Arena& Get() { return g_mFrameArena.Begin(FrameEx::GetFrame()); }
+    // Empty it now, for callers that don't advance FrameEx
+    static void Reset() { g_mFrameArena.Get().Reset(); }
+
+    template <typename T>
+    using Vector = eastl::vector<T, ArenaAllocator::EASTLArenaAllocator>;
+
+    // Usage: auto cops = FrameArenaEx::MakeVector<PVehicle*>(32); cops.push_back(...);
+    template <typename T>
+    static Vector<T> MakeVector(std::size_t capacity = 0) {
+      Vector<T> vector{ArenaAllocator::EASTLArenaAllocator{&Get(), "FrameArenaEx"}};
+      if (capacity) vector.reserve(capacity);
+      return vector;
+    }
+  }  // namespace FrameArenaEx
+
+  //       //
+  // bList //
+  //       //
+
+  namespace ListEx {
+    // Prefetching, length-capped range over a bTList, stops on broken links and cycles
+    // Usage: for (auto* mesh : ListEx::Items(rigidBody->mMeshes)) ...
+    template <typename T>
+    static auto Items(bTList<T>& list, std::size_t maxLength = IntrusiveList::kDefaultMaxLength) {
+      return IntrusiveList::Range<T, bTNode<T>>(&list.HeadNode, maxLength);
+    }
+    // Same over the objects of a bPList
+    template <typename T>
+    static auto Items(bPList<T>& list, std::size_t maxLength = IntrusiveList::kDefaultMaxLength) {
+      return IntrusiveList::Range<T, bTNode<bPNode>, IntrusiveList::ObjectCast<T, bPNode>>(&list.HeadNode, maxLength);
+    }
+  }  // namespace ListEx
+
   //          //
   // PVehicle //
   //          //
@@ -90,17 +210,81 @@ namespace OpenSpeed::Carbon {
       return nullptr;
     }
 
-    // Run a function on all PVehicle instances
-    static void ForEachInstance(const std::function<void(PVehicle* p)>& fn) {
-      auto** pInstance = PVehicle::g_mInstances;
-      if (!pInstance) return;
+    // Capacity of GetInstanceTable(), a list that doesn't loop back by then is cut there; a guess, so Instances() and
+    // ForEachInstance() aren't bounded by it
+    static constexpr std::size_t kMaxInstances = 64;
 
-      auto* instance = *pInstance;
-      while (instance != reinterpret_cast<bTNode<PVehicle*>*>(pInstance)) {
-        if (auto* pvehicle = static_cast<PVehicle*>(instance) | ValidatePVehicle) fn(pvehicle);
-        instance = instance->GetNext();
-      }
+    namespace details {
+      static inline const InstanceTable::ListTable<PVehicle, kMaxInstances, bTNode<PVehicle*>> g_mInstanceTable(
+          PVehicle::g_mInstances);
+
+      // Walks the PVehicle::g_mInstances list back to its head, skipping invalid vehicles
+      struct InstanceCursor {
+        using value_type = PVehicle*;
+
+        bTNode<PVehicle*>* mHead     = reinterpret_cast<bTNode<PVehicle*>*>(PVehicle::g_mInstances);
+        bTNode<PVehicle*>* mInstance = PVehicle::g_mInstances ? *PVehicle::g_mInstances : mHead;
+
+        bool Advance(PVehicle*& out) {
+          while (mInstance != mHead) {
+            out       = static_cast<PVehicle*>(mInstance) | ValidatePVehicle;
+            mInstance = mInstance->GetNext();
+            if (out) return true;
+          }
+          return false;
+        }
+      };
+    }  // namespace details
+
+    // Run a function on all PVehicle instances, returning false from it stops early
+    template <typename Fn>
+    static void ForEachInstance(Fn&& fn) {
+      InstanceRange::ForEach(details::InstanceCursor{}, fn);
     }
+    // Usage: for (auto* pvehicle : PVehicleEx::Instances()) ...
+    static InstanceRange::Range<details::InstanceCursor> Instances() { return {}; }
+
+    // The PVehicle::g_mInstances list flattened by Refresh() for random access, entries aren't validated
+    // Usage: auto& table = PVehicleEx::GetInstanceTable(); table.Refresh(); table.At(i);
+    static const auto& GetInstanceTable() { return details::g_mInstanceTable; }
+    // Same as PVehicle::GetInstancesCount(), but never counts past kMaxInstances; refreshes GetInstanceTable()
+    static std::size_t GetInstancesCount() { return details::g_mInstanceTable.Refresh(); }
+
+    // Spatial hash over PVehicle positions, call Rebuild() once per frame before querying
+    // Usage: index.QueryRadius(player->GetPosition(), 50.0f, [](PVehicle* p, float distanceSquared) { ... });
+    class SpatialIndex : public ::SpatialHash::HashGrid<PVehicle*> {
+     public:
+      void Rebuild() {
+        Clear();
+        ForEachInstance([this](PVehicle* pvehicle) {
+          const auto& position = pvehicle->GetPosition();
+          Add(pvehicle, position.x, position.y, position.z);
+        });
+        Build();
+      }
+
+      using HashGrid::QueryCone;
+      using HashGrid::QueryKNearest;
+      using HashGrid::QueryRadius;
+
+      template <typename Fn>
+      void QueryRadius(const UMath::Vector3& position, float radius, Fn&& fn) const {
+        QueryRadius(position.x, position.y, position.z, radius, fn);
+      }
+      template <typename Fn>
+      void QueryCone(const UMath::Vector3& position, const UMath::Vector3& forward, float cosHalfAngle, float radius,
+                     Fn&& fn) const {
+        QueryCone(position.x, position.y, position.z, forward.x, forward.y, forward.z, cosHalfAngle, radius, fn);
+      }
+      template <typename Filter>
+      void QueryKNearest(const UMath::Vector3& position, std::size_t k, std::vector<Result>& out,
+                         Filter&& filter) const {
+        QueryKNearest(position.x, position.y, position.z, k, out, filter);
+      }
+      void QueryKNearest(const UMath::Vector3& position, std::size_t k, std::vector<Result>& out) const {
+        QueryKNearest(position.x, position.y, position.z, k, out);
+      }
+    };
 
     // Change target PVehicle model
     static details::ChangedPVehicleInfo ChangePVehicleInto(
@@ -184,12 +368,8 @@ namespace OpenSpeed::Carbon {
 
       struct AIVehicleCast_t {
         AIVehicle* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicle*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x9C3D80) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicle) ? ai : nullptr;
         }
       };
       static AIVehicle* operator|(IVehicleAI* i, AIVehicleCast_t ext) { return ext(i); }
@@ -200,12 +380,8 @@ namespace OpenSpeed::Carbon {
 
       struct AIVehicleCopCarCast_t {
         AIVehicleCopCar* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleCopCar*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x9C4A40) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleCopCar) ? ai : nullptr;
         }
       };
       static AIVehicleCopCar* operator|(IVehicleAI* i, AIVehicleCopCarCast_t ext) { return ext(i); }
@@ -216,12 +392,8 @@ namespace OpenSpeed::Carbon {
 
       struct AIVehicleEmptyCast_t {
         AIVehicleEmpty* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleEmpty*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x9C47D0) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleEmpty) ? ai : nullptr;
         }
       };
       static AIVehicleEmpty* operator|(IVehicleAI* iAI, AIVehicleEmptyCast_t ext) { return ext(iAI); }
@@ -232,12 +404,8 @@ namespace OpenSpeed::Carbon {
 
       struct AIVehicleGhostCast_t {
         AIVehicleGhost* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleGhost*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x9C45E0) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleGhost) ? ai : nullptr;
         }
       };
       static AIVehicleGhost* operator|(IVehicleAI* i, AIVehicleGhostCast_t ext) { return ext(i); }
@@ -248,12 +416,8 @@ namespace OpenSpeed::Carbon {
 
       struct AIVehicleHumanCast_t {
         AIVehicleHuman* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleHuman*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x9C5260) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleHuman) ? ai : nullptr;
         }
       };
       static AIVehicleHuman* operator|(IVehicleAI* i, AIVehicleHumanCast_t ext) { return ext(i); }
@@ -264,12 +428,8 @@ namespace OpenSpeed::Carbon {
 
       struct AIVehiclePidCast_t {
         AIVehiclePid* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehiclePid*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x9C3F70) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehiclePid) ? ai : nullptr;
         }
       };
       static AIVehiclePid* operator|(IVehicleAI* i, AIVehiclePidCast_t ext) { return ext(i); }
@@ -280,12 +440,8 @@ namespace OpenSpeed::Carbon {
 
       struct AIVehiclePursuitCast_t {
         AIVehiclePursuit* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehiclePursuit*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x9C4360) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehiclePursuit) ? ai : nullptr;
         }
       };
       static AIVehiclePursuit* operator|(IVehicleAI* i, AIVehiclePursuitCast_t ext) { return ext(i); }
@@ -296,12 +452,8 @@ namespace OpenSpeed::Carbon {
 
       struct AIVehicleRacecarCast_t {
         AIVehicleRacecar* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleRacecar*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x9C4F58) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleRacecar) ? ai : nullptr;
         }
       };
       static AIVehicleRacecar* operator|(IVehicleAI* i, AIVehicleRacecarCast_t ext) { return ext(i); }
@@ -312,12 +464,8 @@ namespace OpenSpeed::Carbon {
 
       struct AIVehicleTrafficCast_t {
         AIVehicleTraffic* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleTraffic*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x9C4170) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleTraffic) ? ai : nullptr;
         }
       };
       static AIVehicleTraffic* operator|(IVehicleAI* i, AIVehicleTrafficCast_t ext) { return ext(i); }
@@ -380,29 +528,7 @@ namespace OpenSpeed::Carbon {
 
       struct ValidateIInput_t {
         IInput* operator()(IInput* input) const {
-          if (!input || !MemoryEditor::Get().ValidateMemoryIsInitialized(input)) return nullptr;
-          // Validate ptr
-          auto vfptr = *reinterpret_cast<std::uintptr_t*>(input);
-          // type: AIVehicle
-          if (vfptr == 0x9C3BF8) return input;
-          // type: AIVehiclePid
-          if (vfptr == 0x9C3DE8) return input;
-          // type: AIVehicleEmpty
-          if (vfptr == 0x9C4648) return input;
-          // type: AIVehicleGhost
-          if (vfptr == 0x9C4458) return input;
-          // type: AIPerpVehicle
-          if (vfptr == 0x9C4B48) return input;
-          // type: AIVehicleRaceCar
-          if (vfptr == 0x9C4DD0) return input;
-          // type: AIVehicleHuman
-          if (vfptr == 0x9C50D8) return input;
-          // type: AIVehiclePursuit
-          if (vfptr == 0x9C41D8) return input;
-          // type: AIVehicleCopCar
-          if (vfptr == 0x9C48B8) return input;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(input, TypeInfoEx::kIInput) ? input : nullptr;
         }
       };
       static IInput* operator|(IInput* input, ValidateIInput_t ext) { return ext(input); }
@@ -413,11 +539,7 @@ namespace OpenSpeed::Carbon {
 
       struct ValidateIInputPlayer_t {
         IInputPlayer* operator()(IInputPlayer* inputplayer) const {
-          if (!inputplayer || !MemoryEditor::Get().ValidateMemoryIsInitialized(inputplayer)) return nullptr;
-          // Validate ptr
-          if (*reinterpret_cast<std::uintptr_t*>(inputplayer) == 0x9C4FF0) return inputplayer;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(inputplayer, TypeInfoEx::kIInputPlayer) ? inputplayer : nullptr;
         }
       };
       static IInputPlayer* operator|(IInputPlayer* inputplayer, ValidateIInputPlayer_t ext) { return ext(inputplayer); }
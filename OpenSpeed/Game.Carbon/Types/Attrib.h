@@ -18,6 +18,10 @@
 // clang-format on
 
 #pragma once
+#include <cstddef>  // size_t
+
+#include <OpenSpeed/Core/Hashing/Hashing.hpp>  // Hashing::StringHash32
+
 #include <OpenSpeed/Game.Carbon/Types.h>
 #include <OpenSpeed/Game.Carbon/Types/Attrib/Class.h>
 #include <OpenSpeed/Game.Carbon/Types/Attrib/Collection.h>
@@ -25,14 +29,21 @@
 #include <OpenSpeed/Game.Carbon/Types/Attrib/Definition.h>
 #include <OpenSpeed/Game.Carbon/Types/Attrib/HashMap.h>
 #include <OpenSpeed/Game.Carbon/Types/Attrib/Instance.h>
+#include <OpenSpeed/Game.Carbon/Types/Attrib/Node.h>
 #include <OpenSpeed/Game.Carbon/Types/Attrib/Private.h>
 #include <OpenSpeed/Game.Carbon/Types/Attrib/RefSpec.h>
 #include <OpenSpeed/Game.Carbon/Types/Attrib/RGBA.h>
 
 namespace OpenSpeed::Carbon::Attrib {
-  static inline StringKey StringToKey(const char* name) {
-    return reinterpret_cast<StringKey(__cdecl*)(const char*)>(0x4639D0)(name);
-  }
+  // Native, bit-exact Attrib::StringToKey (0x4639D0), usable at compile time
+  static constexpr StringKey StringToKey(const char* name) { return Hashing::StringHash32(name); }
+
+  inline namespace Literals {
+    // Usage: constexpr Attrib::StringKey key = "pvehicle"_key;
+    constexpr StringKey operator""_key(const char* name, std::size_t length) {
+      return Hashing::StringHash32(name, length);
+    }
+  }  // namespace Literals
 
   static inline Collection* FindCollection(StringKey classKey, StringKey collectionKey) {
     return reinterpret_cast<Collection*(__cdecl*)(StringKey, StringKey)>(0x465930)(classKey, collectionKey);
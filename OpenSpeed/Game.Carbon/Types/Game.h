@@ -18,6 +18,8 @@
 // clang-format on
 
 #pragma once
+#include <OpenSpeed/Core/Hashing/Hashing.hpp>  // Hashing::BStringHash, Hashing::StringHash32
+
 #include <OpenSpeed/Game.Carbon/Types.h>
 
 namespace OpenSpeed::Carbon::Game {
@@ -62,13 +64,9 @@ namespace OpenSpeed::Carbon::Game {
   // Game_ShowPauseMenu
   static inline void ShowPauseMenu() { reinterpret_cast<void(__cdecl*)()>(0x64B620)(); }
 
-  // custom hashing
-  static inline std::uint32_t bStringHash(const char* cstring) {
-    return reinterpret_cast<std::uint32_t(__cdecl*)(const char*)>(0x471050)(cstring);
-  }
+  // custom hashing, native bStringHash (0x471050)
+  static constexpr std::uint32_t bStringHash(const char* cstring) { return Hashing::BStringHash(cstring); }
 
-  // uses 0xABCDEF00 magic
-  static inline std::uint32_t stringhash32(const char* cstring) {
-    return reinterpret_cast<std::uint32_t(__cdecl*)(const char*)>(0x606B60)(cstring);
-  }
+  // uses 0xABCDEF00 magic, native stringhash32 (0x606B60)
+  static constexpr std::uint32_t stringhash32(const char* cstring) { return Hashing::StringHash32(cstring); }
 }  // namespace OpenSpeed::Carbon::Game
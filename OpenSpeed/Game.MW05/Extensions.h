@@ -18,11 +18,41 @@
 // clang-format on
 
 #pragma once
-#include <functional>  // std::function
-
-#include <OpenSpeed/Core/MemoryEditor/MemoryEditor.hpp>  // ValidateMemoryIsInitialized
-
+#include <algorithm>         // min, remove_if
+#include <atomic>            // atomic
+#include <cfloat>            // FLT_MAX
+#include <cmath>             // sqrt
+#include <initializer_list>  // initializer_list
+#include <iterator>          // size
+#include <memory>            // unique_ptr
+#include <mutex>             // mutex, scoped_lock
+#include <unordered_map>     // unordered_map
+#include <vector>            // vector
+#include <xmmintrin.h>       // SSE intrinsics
+
+#include <OpenSpeed/Core/ArenaAllocator/ArenaAllocator.hpp>            // ArenaAllocator::Arena, FrameArena
+#include <OpenSpeed/Core/AttribAccessor/AttribAccessor.hpp>            // AttribAccessor::Table
+#include <OpenSpeed/Core/AttribFlatView/AttribFlatView.hpp>            // AttribFlatView::View
+#include <OpenSpeed/Core/BodyIntegrator/BodyIntegrator.hpp>            // BodyIntegrator::Batch
+#include <OpenSpeed/Core/EASTL/EASTL/vector.h>                         // eastl::vector
+#include <OpenSpeed/Core/EASTLView/EASTLView.hpp>                      // EASTLView::Map
+#include <OpenSpeed/Core/GenerationCache/GenerationCache.hpp>          // GenerationCache::Table
+#include <OpenSpeed/Core/InstanceRange/InstanceRange.hpp>              // InstanceRange::Range, ForEach
+#include <OpenSpeed/Core/InstanceTable/InstanceTable.hpp>              // InstanceTable::Table
+#include <OpenSpeed/Core/IntrusiveList/IntrusiveList.hpp>              // IntrusiveList::Range
+#include <OpenSpeed/Core/LockFreeQueue/LockFreeQueue.hpp>              // LockFreeQueue::Queue
+#include <OpenSpeed/Core/MemoryEditor/MemoryEditor.hpp>                // ValidateMemoryIsInitialized
+#include <OpenSpeed/Core/SpatialHash/SpatialHash.hpp>                  // SpatialHash::HashGrid
+#include <OpenSpeed/Core/SweepAndPrune/SweepAndPrune.hpp>              // SweepAndPrune::Broadphase
+#include <OpenSpeed/Core/TrajectoryPredictor/TrajectoryPredictor.hpp>  // TrajectoryPredictor::Predictor
+#include <OpenSpeed/Core/TypeTable/TypeTable.hpp>                      // TypeTable::Table
+#include <OpenSpeed/Core/UTLView/UTLView.hpp>                          // UTLView::View
+#include <OpenSpeed/Core/WorkerPool/WorkerPool.hpp>                    // WorkerPool::Pool
+
+#include <OpenSpeed/Game.MW05/MW05.h>  // Variables::TheOneCopManager
 #include <OpenSpeed/Game.MW05/Types.h>
+#include <OpenSpeed/Game.MW05/Types/ActionQueue.h>      // ActionQueue, ActionData
+#include <OpenSpeed/Game.MW05/Types/AICopManager.h>     // AICopManager
 #include <OpenSpeed/Game.MW05/Types/AIVehicleCopCar.h>  // AIVehicleCopCar, AIVehiclePursuit, AIVehiclePid, AIVehicle
 #include <OpenSpeed/Game.MW05/Types/AIVehicleEmpty.h>   // AIVehicleEmpty
 #include <OpenSpeed/Game.MW05/Types/AIVehicleHelicopter.h>  // AIVehicleHelicopter
@@ -31,15 +61,147 @@
 #include <OpenSpeed/Game.MW05/Types/DamageCopCar.h>     // DamageCopCar, DamageVehicle, IDamageable, IDamageableVehicle
 #include <OpenSpeed/Game.MW05/Types/DamageDragster.h>   // DamageDragster, DamageRacer, ISpikeable
 #include <OpenSpeed/Game.MW05/Types/DamageHeli.h>       // DamageHeli
+#include <OpenSpeed/Game.MW05/Types/Dynamics.h>         // Dynamics::Collision::Geometry
+#include <OpenSpeed/Game.MW05/Types/GManager.h>         // GManager
 #include <OpenSpeed/Game.MW05/Types/GRaceStatus.h>      // GRaceStatus
 #include <OpenSpeed/Game.MW05/Types/InputPlayer.h>      // InputPlayer, PInput, IInput
 #include <OpenSpeed/Game.MW05/Types/LocalPlayer.h>      // LocalPlayer, IPlayer
 #include <OpenSpeed/Game.MW05/Types/PVehicle.h>         // PVehicle
+#include <OpenSpeed/Game.MW05/Types/RBGrid.h>           // RBGrid
 #include <OpenSpeed/Game.MW05/Types/RBSmackable.h>      // RBSmackable, RigidBody, IRigidBody
 #include <OpenSpeed/Game.MW05/Types/RBTractor.h>        // RBTractor, RBVehicle
 #include <OpenSpeed/Game.MW05/Types/SimpleRigidBody.h>  // SimpleRigidBody, ISimpleBody
 
 namespace OpenSpeed::MW05 {
+  //           //
+  // Type info //
+  //           //
+
+  namespace TypeInfoEx {
+    // One bit per verified cast; a vtable's mask has the bit of every cast that accepts it
+    enum TypeBits : std::uint64_t {
+      kRigidBody           = 1ull << 0,
+      kRBSmackable         = 1ull << 1,
+      kRBVehicle           = 1ull << 2,
+      kRBTractor           = 1ull << 3,
+      kSimpleRigidBody     = 1ull << 4,
+      kPInput              = 1ull << 5,
+      kInputPlayer         = 1ull << 6,
+      kAIVehicle           = 1ull << 7,
+      kAIVehicleCopCar     = 1ull << 8,
+      kAIVehicleEmpty      = 1ull << 9,
+      kAIVehicleHelicopter = 1ull << 10,
+      kAIVehicleHuman      = 1ull << 11,
+      kAIVehiclePid        = 1ull << 12,
+      kAIVehiclePursuit    = 1ull << 13,
+      kAIVehicleRacecar    = 1ull << 14,
+      kAIVehicleTraffic    = 1ull << 15,
+      kDamageVehicle       = 1ull << 16,
+      kDamageCopCar        = 1ull << 17,
+      kDamageHeli          = 1ull << 18,
+      kDamageRacer         = 1ull << 19,
+      kDamageDragster      = 1ull << 20,
+      kPlayer              = 1ull << 21,
+      kLocalPlayer         = 1ull << 22,
+    };
+
+    static constexpr TypeTable::Table<23> kTypeTable({{
+        {0x891A80, kAIVehicle},                                       // AIVehicle
+        {0x891BB8, kAIVehiclePid},                                    // AIVehiclePid
+        {0x891CF8, kAIVehicleTraffic},                                // AIVehicleTraffic
+        {0x891EC0, kAIVehiclePursuit},                                // AIVehiclePursuit
+        {0x8920D8, kAIVehicleHelicopter},                             // AIVehicleHelicopter
+        {0x892560, kAIVehicleCopCar},                                 // AIVehicleCopCar
+        {0x892720, kAIVehicleRacecar},                                // AIVehicleRacecar
+        {0x892AD0, kAIVehicleHuman},                                  // AIVehicleHuman
+        {0x892E28, kAIVehicleEmpty},                                  // AIVehicleEmpty
+        {0x8AA6D0, kRigidBody | kRBSmackable},                        // RBSmackable
+        {0x8AB598, kPInput},                                          // PInput
+        {0x8AC448, kRigidBody},                                       // RigidBody
+        {0x8AC5FC, kSimpleRigidBody},                                 // SimpleRigidBody
+        {0x8AC6BC, kInputPlayer},                                     // InputPlayer
+        {0x8AC938, kRigidBody | kRBVehicle},                          // RBVehicle
+        {0x8ACBA8, kRigidBody | kRBVehicle | kRBTractor},             // RBTractor
+        {0x8AD2CC, kDamageVehicle},                                   // DamageVehicle
+        {0x8AD350, kDamageVehicle | kDamageRacer},                    // DamageRacer
+        {0x8AD3C4, kDamageVehicle | kDamageHeli},                     // DamageHeli
+        {0x8AD438, kDamageVehicle | kDamageCopCar},                   // DamageCopCar
+        {0x8AD6AC, kDamageVehicle | kDamageRacer | kDamageDragster},  // DamageDragster
+        {0x8B0B10, kPlayer},                                          // LocalPlayer (IPlayer)
+        {0x8B0BB0, kLocalPlayer},                                     // LocalPlayer
+    }});
+
+    // Type bits of an object from its vtable, 0 if its memory is bad or the type is unknown; one lookup answers
+    // every cast at once
+    // Usage: auto mask = TypeInfoEx::GetTypeMask(iRB); if (mask & TypeInfoEx::kRBVehicle) ...
+    template <typename T>
+    static std::uint64_t GetTypeMask(T* object) {
+      if (!object || !MemoryEditor::Get().ValidateMemoryIsInitialized(object)) return 0;
+      return kTypeTable.Find(*reinterpret_cast<const std::uintptr_t*>(object));
+    }
+    template <typename T>
+    static bool Is(T* object, std::uint64_t bits) {
+      return (GetTypeMask(object) & bits) != 0;
+    }
+  }  // namespace TypeInfoEx
+
+  //       //
+  // Frame //
+  //       //
+
+  namespace FrameEx {
+    static inline std::uint32_t g_mFrame = 0;
+
+    // Advance the counter per-frame caches are keyed on. Nothing in here hooks the main loop, so the mod has to call
+    // it once per frame from its own hook; FrameSnapshotEx::Capture() does it for you.
+    static void          NextFrame() { g_mFrame++; }
+    static std::uint32_t GetFrame() { return g_mFrame; }
+  }  // namespace FrameEx
+
+  //            //
+  // FrameArena //
+  //            //
+
+  namespace FrameArenaEx {
+    static inline ArenaAllocator::FrameArena g_mFrameArena{256 * 1024};
+
+    // Scratch memory for per-frame analysis, emptied the first time it is used after FrameEx::NextFrame(). Without
+    // those calls it is never emptied and keeps growing, call Reset() instead then. Game thread only, and nothing
+    // allocated from it may be kept into the next frame.
+    static ArenaAllocator::Arena& Get() { return g_mFrameArena.Begin(FrameEx::GetFrame()); }
+    // Empty it now, for callers that don't advance FrameEx
+    static void Reset() { g_mFrameArena.Get().Reset(); }
+
+    template <typename T>
+    using Vector = eastl::vector<T, ArenaAllocator::EASTLArenaAllocator>;
+
+    // Usage: auto cops = FrameArenaEx::MakeVector<PVehicle*>(32); cops.push_back(...);
+    template <typename T>
+    static Vector<T> MakeVector(std::size_t capacity = 0) {
+      Vector<T> vector{ArenaAllocator::EASTLArenaAllocator{&Get(), "FrameArenaEx"}};
+      if (capacity) vector.reserve(capacity);
+      return vector;
+    }
+  }  // namespace FrameArenaEx
+
+  //       //
+  // bList //
+  //       //
+
+  namespace ListEx {
+    // Prefetching, length-capped range over a bTList, stops on broken links and cycles
+    // Usage: for (auto* mesh : ListEx::Items(rigidBody->mMeshes)) ...
+    template <typename T>
+    static auto Items(bTList<T>& list, std::size_t maxLength = IntrusiveList::kDefaultMaxLength) {
+      return IntrusiveList::Range<T, bTNode<T>>(&list.HeadNode, maxLength);
+    }
+    // Same over the objects of a bPList
+    template <typename T>
+    static auto Items(bPList<T>& list, std::size_t maxLength = IntrusiveList::kDefaultMaxLength) {
+      return IntrusiveList::Range<T, bTNode<bPNode>, IntrusiveList::ObjectCast<T, bPNode>>(&list.HeadNode, maxLength);
+    }
+  }  // namespace ListEx
+
   //          //
   // PVehicle //
   //          //
@@ -90,11 +252,76 @@ namespace OpenSpeed::MW05 {
       return nullptr;
     }
 
-    // Run a function on all PVehicle instances
-    static void ForEachInstance(const std::function<void(PVehicle* p)>& fn) {
-      auto* _instance = PVehicle::g_mInstances;
-      while (auto* pvehicle = ((_instance++)->mInstance | ValidatePVehicle)) fn(pvehicle);
+    // Capacity of GetInstanceTable(); a guess, the size of PVehicle::g_mInstances isn't known, so Instances() and
+    // ForEachInstance() aren't bounded by it
+    static constexpr std::size_t kMaxInstances = 64;
+
+    namespace details {
+      static inline const InstanceTable::Table<PVehicle, kMaxInstances, PVehicle::_InstanceLayout> g_mInstanceTable(
+          PVehicle::g_mInstances);
+
+      // Walks PVehicle::g_mInstances up to the first invalid entry
+      struct InstanceCursor {
+        using value_type = PVehicle*;
+
+        decltype(PVehicle::g_mInstances) mInstance = PVehicle::g_mInstances;
+
+        bool Advance(PVehicle*& out) {
+          out = (mInstance++)->mInstance | ValidatePVehicle;
+          return out != nullptr;
+        }
+      };
+    }  // namespace details
+
+    // Bounded view of PVehicle::g_mInstances with random access, entries aren't validated
+    // Usage: for (auto* pvehicle : PVehicleEx::GetInstanceTable()) ...
+    static const auto& GetInstanceTable() { return details::g_mInstanceTable; }
+    // Same as PVehicle::GetInstancesCount(), but never counts past kMaxInstances
+    static std::size_t GetInstancesCount() { return details::g_mInstanceTable.GetCount(); }
+
+    // Run a function on all PVehicle instances, returning false from it stops early
+    template <typename Fn>
+    static void ForEachInstance(Fn&& fn) {
+      InstanceRange::ForEach(details::InstanceCursor{}, fn);
     }
+    // Usage: for (auto* pvehicle : PVehicleEx::Instances()) ...
+    static InstanceRange::Range<details::InstanceCursor> Instances() { return {}; }
+
+    // Spatial hash over PVehicle positions, call Rebuild() once per frame before querying
+    // Usage: index.QueryRadius(player->GetPosition(), 50.0f, [](PVehicle* p, float distanceSquared) { ... });
+    class SpatialIndex : public ::SpatialHash::HashGrid<PVehicle*> {
+     public:
+      void Rebuild() {
+        Clear();
+        ForEachInstance([this](PVehicle* pvehicle) {
+          const auto& position = pvehicle->GetPosition();
+          Add(pvehicle, position.x, position.y, position.z);
+        });
+        Build();
+      }
+
+      using HashGrid::QueryCone;
+      using HashGrid::QueryKNearest;
+      using HashGrid::QueryRadius;
+
+      template <typename Fn>
+      void QueryRadius(const UMath::Vector3& position, float radius, Fn&& fn) const {
+        QueryRadius(position.x, position.y, position.z, radius, fn);
+      }
+      template <typename Fn>
+      void QueryCone(const UMath::Vector3& position, const UMath::Vector3& forward, float cosHalfAngle, float radius,
+                     Fn&& fn) const {
+        QueryCone(position.x, position.y, position.z, forward.x, forward.y, forward.z, cosHalfAngle, radius, fn);
+      }
+      template <typename Filter>
+      void QueryKNearest(const UMath::Vector3& position, std::size_t k, std::vector<Result>& out,
+                         Filter&& filter) const {
+        QueryKNearest(position.x, position.y, position.z, k, out, filter);
+      }
+      void QueryKNearest(const UMath::Vector3& position, std::size_t k, std::vector<Result>& out) const {
+        QueryKNearest(position.x, position.y, position.z, k, out);
+      }
+    };
 
     // Change target PVehicle model
     static details::ChangedPVehicleInfo ChangePVehicleInto(
@@ -166,20 +393,8 @@ namespace OpenSpeed::MW05 {
 
       struct RigidBodyCast_t {
         RigidBody* operator()(IRigidBody* iRB) const {
-          if (!iRB || !MemoryEditor::Get().ValidateMemoryIsInitialized(iRB)) return nullptr;
-          // Verify cast
-          auto* rb    = static_cast<RigidBody*>(iRB);
-          auto  vfptr = *reinterpret_cast<std::uintptr_t*>(rb);
-          // type: RigidBody
-          if (vfptr == 0x8AC448) return rb;
-          // type: RBSmackable
-          if (vfptr == 0x8AA6D0) return rb;
-          // type: RBVehicle
-          if (vfptr == 0x8AC938) return rb;
-          // type: RBTractor
-          if (vfptr == 0x8ACBA8) return rb;
-          // Bad cast
-          return nullptr;
+          auto* rb = static_cast<RigidBody*>(iRB);
+          return TypeInfoEx::Is(rb, TypeInfoEx::kRigidBody) ? rb : nullptr;
         }
       };
       static RigidBody* operator|(IRigidBody* iRB, RigidBodyCast_t ext) { return ext(iRB); }
@@ -190,12 +405,8 @@ namespace OpenSpeed::MW05 {
 
       struct RBSmackableCast_t {
         RBSmackable* operator()(IRigidBody* iRB) const {
-          if (!iRB || !MemoryEditor::Get().ValidateMemoryIsInitialized(iRB)) return nullptr;
-          // Verify cast
           auto* rb = static_cast<RBSmackable*>(iRB);
-          if (*reinterpret_cast<std::uintptr_t*>(rb) == 0x8AA6D0) return rb;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(rb, TypeInfoEx::kRBSmackable) ? rb : nullptr;
         }
       };
       static RBSmackable* operator|(IRigidBody* iRB, RBSmackableCast_t ext) { return ext(iRB); }
@@ -206,16 +417,8 @@ namespace OpenSpeed::MW05 {
 
       struct RBVehicleCast_t {
         RBVehicle* operator()(IRigidBody* iRB) const {
-          if (!iRB || !MemoryEditor::Get().ValidateMemoryIsInitialized(iRB)) return nullptr;
-          // Verify cast
-          auto* rb    = static_cast<RBVehicle*>(iRB);
-          auto  vfptr = *reinterpret_cast<std::uintptr_t*>(rb);
-          // type: RBVehicle
-          if (vfptr == 0x8AC938) return rb;
-          // type: RBTractor
-          if (vfptr == 0x8ACBA8) return rb;
-          // Bad cast
-          return nullptr;
+          auto* rb = static_cast<RBVehicle*>(iRB);
+          return TypeInfoEx::Is(rb, TypeInfoEx::kRBVehicle) ? rb : nullptr;
         }
       };
       static RBVehicle* operator|(IRigidBody* iRB, RBVehicleCast_t ext) { return ext(iRB); }
@@ -226,12 +429,8 @@ namespace OpenSpeed::MW05 {
 
       struct RBTractorCast_t {
         RBTractor* operator()(IRigidBody* iRB) const {
-          if (!iRB || !MemoryEditor::Get().ValidateMemoryIsInitialized(iRB)) return nullptr;
-          // Verify cast
           auto* rb = static_cast<RBTractor*>(iRB);
-          if (*reinterpret_cast<std::uintptr_t*>(rb) == 0x8ACBA8) return rb;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(rb, TypeInfoEx::kRBTractor) ? rb : nullptr;
         }
       };
       static RBTractor* operator|(IRigidBody* iRB, RBTractorCast_t ext) { return ext(iRB); }
@@ -242,12 +441,8 @@ namespace OpenSpeed::MW05 {
 
       struct SimpleRigidBodyCast_t {
         SimpleRigidBody* operator()(IRigidBody* iRB) const {
-          if (!iRB || !MemoryEditor::Get().ValidateMemoryIsInitialized(iRB)) return nullptr;
-          // Verify cast
           auto* rb = static_cast<SimpleRigidBody*>(iRB);
-          if (*reinterpret_cast<std::uintptr_t*>(rb) == 0x8AC5FC) return rb;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(rb, TypeInfoEx::kSimpleRigidBody) ? rb : nullptr;
         }
       };
       static SimpleRigidBody* operator|(IRigidBody* iRB, SimpleRigidBodyCast_t ext) { return ext(iRB); }
@@ -273,6 +468,12 @@ namespace OpenSpeed::MW05 {
     // Usage: SimpleRigidBody* myptr = GetRigidBodyPtr() | RigidBodyEx::AsSimpleRigidBody;
     static inline const details::SimpleRigidBodyCast_t AsSimpleRigidBody;
 
+    // Collision primitives of a rigid body
+    // Usage: for (auto* primitive : RigidBodyEx::Primitives(rigidBody)) ...
+    static auto Primitives(RigidBody* rigidBody) { return ListEx::Items(rigidBody->mPrimitives); }
+    // Collision meshes of a rigid body
+    static auto Meshes(RigidBody* rigidBody) { return ListEx::Items(rigidBody->mMeshes); }
+
     // Get a pointer to the player IRigidBody instance
     static IRigidBody* GetPlayerInstance() {
       auto* pvehicle = PVehicleEx::GetPlayerInstance();
@@ -281,12 +482,177 @@ namespace OpenSpeed::MW05 {
       return nullptr;
     }
 
-    // Run a function on all RigidBody::Volatile instances
-    static void ForEachInstance(const std::function<void(RigidBody::Volatile* p)>& fn) {
-      auto* _instance = RigidBody::Volatile::g_mInstances;
-      while (auto* volatileData = *(_instance++))
-        if (MemoryEditor::Get().ValidateMemoryIsInitialized(volatileData)) fn(volatileData);
+    // Upper bound for RigidBody::Volatile::g_mInstances, the SimpleRigidBody table starts 0x100 bytes after it
+    static constexpr std::size_t kMaxInstances = 64;
+
+    namespace details {
+      static inline const InstanceTable::Table<RigidBody::Volatile, kMaxInstances> g_mVolatileTable(
+          RigidBody::Volatile::g_mInstances);
+
+      // Walks RigidBody::Volatile::g_mInstances up to the terminating null, skipping uninitialized entries
+      struct VolatileCursor {
+        using value_type = RigidBody::Volatile*;
+
+        RigidBody::Volatile** mInstance = RigidBody::Volatile::g_mInstances;
+        RigidBody::Volatile** mEnd      = RigidBody::Volatile::g_mInstances + kMaxInstances;
+
+        bool Advance(RigidBody::Volatile*& out) {
+          while (mInstance != mEnd && (out = *mInstance)) {
+            mInstance++;
+            if (MemoryEditor::Get().ValidateMemoryIsInitialized(out)) return true;
+          }
+          return false;
+        }
+      };
+    }  // namespace details
+
+    // Run a function on all RigidBody::Volatile instances, returning false from it stops early
+    template <typename Fn>
+    static void ForEachInstance(Fn&& fn) {
+      InstanceRange::ForEach(details::VolatileCursor{}, fn);
     }
+    // Usage: for (auto* volatileData : RigidBodyEx::Volatiles()) ...
+    static InstanceRange::Range<details::VolatileCursor> Volatiles() { return {}; }
+
+    // Bounded view of RigidBody::Volatile::g_mInstances with random access, entries aren't validated
+    static const auto& GetVolatileTable() { return details::g_mVolatileTable; }
+    // Same as RigidBody::Volatile::GetInstancesCount(), but never reads past kMaxInstances
+    static std::size_t GetVolatilesCount() { return details::g_mVolatileTable.GetCount(); }
+
+    // Sweep-and-prune broadphase over the same X/Z endpoints as the game's RBGrid
+    class Broadphase : public SweepAndPrune::Broadphase<RigidBody*> {
+      using Node = RBGrid::Axis::Node;
+
+      struct Entry {
+        Handle mHandle;
+        bool   mIsSeen;
+      };
+      std::unordered_map<RigidBody*, Entry> mBodies;
+
+      // Every body has a min and a max node on the X axis
+      static constexpr std::size_t kMaxNodes = 2 * kMaxInstances;
+
+      // Insert the owners of the nodes linked from 'node' through 'next', both directions together cover the axis
+      void InsertLinked(const Node* node, Node* Node::*next) {
+        std::size_t count = 0;
+        for (auto* it = node->*next; it && it != node && count < kMaxNodes; it = it->*next, count++)
+          Insert(&it->mAxis.mGrid.mOwner);
+      }
+
+     public:
+      // Add or refresh a rigid body from its grid node, returns kInvalidHandle if it has none
+      Handle Insert(RigidBody* rigidBody) {
+        if (!rigidBody || !MemoryEditor::Get().ValidateMemoryIsInitialized(rigidBody) || !rigidBody->mGrid)
+          return kInvalidHandle;
+
+        auto [it, isNew]   = mBodies.try_emplace(rigidBody, Entry{kInvalidHandle, true});
+        it->second.mIsSeen = true;
+        if (isNew)
+          it->second.mHandle = AddGrid(rigidBody, *rigidBody->mGrid);
+        else
+          UpdateGrid(it->second.mHandle, *rigidBody->mGrid);
+        return it->second.mHandle;
+      }
+      void Erase(RigidBody* rigidBody) {
+        auto it = mBodies.find(rigidBody);
+        if (it == mBodies.end()) return;
+
+        Remove(it->second.mHandle);
+        mBodies.erase(it);
+      }
+
+      // Seed/refresh from every rigid body on the game's grid (vehicles, props, RBSmackable), dropping bodies that
+      // are gone. The game keeps no list of RigidBody instances, so the grid is reached through any vehicle's node.
+      void Sync() {
+        for (auto& [rigidBody, entry] : mBodies) entry.mIsSeen = false;
+
+        RigidBody* seed = nullptr;
+        PVehicleEx::ForEachInstance([&seed](PVehicle* pvehicle) {
+          auto* rigidBody = pvehicle->GetRigidBody() | AsRigidBody;
+          if (rigidBody && rigidBody->mGrid) seed = rigidBody;
+          return seed == nullptr;
+        });
+        if (seed) {
+          const auto* node = &seed->mGrid->mX.mMin;
+          Insert(seed);
+          InsertLinked(node, &Node::mHead);
+          InsertLinked(node, &Node::mTail);
+        }
+
+        for (auto it = mBodies.begin(); it != mBodies.end();) {
+          if (it->second.mIsSeen) {
+            ++it;
+            continue;
+          }
+          Remove(it->second.mHandle);
+          it = mBodies.erase(it);
+        }
+      }
+    };
+
+    //                //
+    // Dead reckoning //
+    //                //
+
+    static_assert(sizeof(RigidBody::Volatile) == sizeof(BodyIntegrator::Layout::Volatile),
+                  "BodyIntegrator::Layout::Volatile is out of date.");
+
+    // Predicts body states between and past physics ticks without calling into the game. Bodies the game doesn't
+    // integrate (inactive, attached or with the integrator disabled) are loaded at rest.
+    // Usage: predictor.Load(); predictor.Advance(1.0f / 60.0f, 3); predictor.GetPosition(predictor.Find(body));
+    class Predictor {
+      BodyIntegrator::Batch<kMaxInstances> mBatch;
+      RigidBody::Volatile*                 mInstances[kMaxInstances];
+
+      static bool IsIntegrated(RigidBody::Volatile* volatileData) {
+        return !volatileData->GetStatus(RigidBody::Volatile::Status::Inactive) &&
+               !volatileData->GetStatus(RigidBody::Volatile::Status::Attached) &&
+               !volatileData->GetStatus(RigidBody::Volatile::Status::DisableIntegrator);
+      }
+
+     public:
+      // Reload every live body's current state, returns how many were loaded
+      std::size_t Load() {
+        mBatch.Clear();
+        ForEachInstance([this](RigidBody::Volatile* volatileData) {
+          auto state = BodyIntegrator::ToState(*volatileData);
+          if (!IsIntegrated(volatileData)) {
+            for (std::size_t k = 0; k < 3; k++)
+              state.mLinearVelocity[k] = state.mAngularVelocity[k] = state.mForce[k] = state.mTorque[k] = 0.0f;
+          }
+
+          const auto idx = mBatch.Add(state);
+          if (idx < 0) return false;
+
+          mInstances[idx] = volatileData;
+          return true;
+        });
+        return mBatch.GetCount();
+      }
+
+      // 'steps' steps of 'dt', the last force and torque are held unless GetBatch().ClearForces() is called first
+      void Advance(float dt, std::size_t steps = 1) { mBatch.Advance(dt, steps); }
+
+      // Index of a body from the last Load(), -1 if it wasn't loaded
+      std::int32_t Find(const RigidBody::Volatile* volatileData) const {
+        for (std::size_t i = 0; i < mBatch.GetCount(); i++)
+          if (mInstances[i] == volatileData) return static_cast<std::int32_t>(i);
+        return -1;
+      }
+      std::size_t          GetCount() const { return mBatch.GetCount(); }
+      RigidBody::Volatile* GetInstance(std::size_t idx) const { return mInstances[idx]; }
+
+      // Unchecked, 'idx' must be below GetCount()
+      UMath::Vector3 GetPosition(std::size_t idx) const {
+        float position[3];
+        mBatch.GetPosition(idx, position);
+        return UMath::Vector3(position[0], position[1], position[2]);
+      }
+      void GetState(std::size_t idx, BodyIntegrator::State& out) const { mBatch.Get(idx, out); }
+
+      BodyIntegrator::Batch<kMaxInstances>&       GetBatch() { return mBatch; }
+      const BodyIntegrator::Batch<kMaxInstances>& GetBatch() const { return mBatch; }
+    };
   }  // namespace RigidBodyEx
 
   //             //
@@ -302,12 +668,8 @@ namespace OpenSpeed::MW05 {
 
       struct SimpleRigidBodyCast_t {
         SimpleRigidBody* operator()(ISimpleBody* iSRB) const {
-          if (!iSRB || !MemoryEditor::Get().ValidateMemoryIsInitialized(iSRB)) return nullptr;
-          // Verify cast
           auto* srb = static_cast<SimpleRigidBody*>(iSRB);
-          if (*reinterpret_cast<std::uintptr_t*>(srb) == 0x8AC5FC) return srb;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(srb, TypeInfoEx::kSimpleRigidBody) ? srb : nullptr;
         }
       };
       static SimpleRigidBody* operator|(ISimpleBody* iSRB, SimpleRigidBodyCast_t ext) { return ext(iSRB); }
@@ -317,14 +679,371 @@ namespace OpenSpeed::MW05 {
     // Usage: SimpleRigidBody* myptr = GetSimpleBodyPtr() | SimpleBodyEx::AsSimpleRigidBody;
     static inline const details::SimpleRigidBodyCast_t AsSimpleRigidBody;
 
-    // Run a function on all SimpleRigidBody::Volatile instances
-    static void ForEachInstance(const std::function<void(SimpleRigidBody::Volatile* p)>& fn) {
-      auto* _instance = SimpleRigidBody::Volatile::g_mInstances;
-      while (auto* volatileData = *(_instance++))
-        if (MemoryEditor::Get().ValidateMemoryIsInitialized(volatileData)) fn(volatileData);
+    // Capacity of GetVolatileTable(); a guess, the size of SimpleRigidBody::Volatile::g_mInstances isn't known, so
+    // Volatiles() and ForEachInstance() aren't bounded by it
+    static constexpr std::size_t kMaxInstances = 64;
+
+    namespace details {
+      static inline const InstanceTable::Table<SimpleRigidBody::Volatile, kMaxInstances> g_mVolatileTable(
+          SimpleRigidBody::Volatile::g_mInstances);
+
+      // Walks SimpleRigidBody::Volatile::g_mInstances up to the terminating null, skipping uninitialized entries
+      struct VolatileCursor {
+        using value_type = SimpleRigidBody::Volatile*;
+
+        SimpleRigidBody::Volatile** mInstance = SimpleRigidBody::Volatile::g_mInstances;
+
+        bool Advance(SimpleRigidBody::Volatile*& out) {
+          while ((out = *mInstance)) {
+            mInstance++;
+            if (MemoryEditor::Get().ValidateMemoryIsInitialized(out)) return true;
+          }
+          return false;
+        }
+      };
+    }  // namespace details
+
+    // Run a function on all SimpleRigidBody::Volatile instances, returning false from it stops early
+    template <typename Fn>
+    static void ForEachInstance(Fn&& fn) {
+      InstanceRange::ForEach(details::VolatileCursor{}, fn);
     }
+    // Usage: for (auto* volatileData : SimpleBodyEx::Volatiles()) ...
+    static InstanceRange::Range<details::VolatileCursor> Volatiles() { return {}; }
+
+    // Bounded view of SimpleRigidBody::Volatile::g_mInstances with random access, entries aren't validated
+    static const auto& GetVolatileTable() { return details::g_mVolatileTable; }
+    // Same as SimpleRigidBody::Volatile::GetInstancesCount(), but never counts past kMaxInstances
+    static std::size_t GetVolatilesCount() { return details::g_mVolatileTable.GetCount(); }
   }  // namespace SimpleBodyEx
 
+  //           //
+  // Collision //
+  //           //
+
+  namespace CollisionEx {
+    namespace details {
+      //               //
+      // Internal math //
+      //               //
+
+      // Rotation matrix columns (local axes in world space) of a unit quaternion [x, y, z, w]
+      static void QuaternionToAxes(float qx, float qy, float qz, float qw, float (&axes)[3][3]) {
+        axes[0][0] = 1.0f - 2.0f * (qy * qy + qz * qz);
+        axes[0][1] = 2.0f * (qx * qy + qw * qz);
+        axes[0][2] = 2.0f * (qx * qz - qw * qy);
+        axes[1][0] = 2.0f * (qx * qy - qw * qz);
+        axes[1][1] = 1.0f - 2.0f * (qx * qx + qz * qz);
+        axes[1][2] = 2.0f * (qy * qz + qw * qx);
+        axes[2][0] = 2.0f * (qx * qz + qw * qy);
+        axes[2][1] = 2.0f * (qy * qz - qw * qx);
+        axes[2][2] = 1.0f - 2.0f * (qx * qx + qy * qy);
+      }
+
+      // Hamilton product, 'lhs * rhs' applies 'rhs' first
+      static void MultiplyQuaternion(const float (&lhs)[4], const float (&rhs)[4], float (&out)[4]) {
+        out[0] = lhs[3] * rhs[0] + lhs[0] * rhs[3] + lhs[1] * rhs[2] - lhs[2] * rhs[1];
+        out[1] = lhs[3] * rhs[1] - lhs[0] * rhs[2] + lhs[1] * rhs[3] + lhs[2] * rhs[0];
+        out[2] = lhs[3] * rhs[2] + lhs[0] * rhs[1] - lhs[1] * rhs[0] + lhs[2] * rhs[3];
+        out[3] = lhs[3] * rhs[3] - lhs[0] * rhs[0] - lhs[1] * rhs[1] - lhs[2] * rhs[2];
+      }
+
+      static inline __m128 Select(__m128 mask, __m128 a, __m128 b) {
+        return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+      }
+      static inline __m128 Abs(__m128 v) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), v); }
+      // 1 / sqrt(v), _mm_rsqrt_ps refined by one Newton-Raphson step (~22 bits instead of ~12)
+      static inline __m128 InvSqrt(__m128 v) {
+        const __m128 r = _mm_rsqrt_ps(v);
+        const __m128 halfVRR = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(0.5f), v), _mm_mul_ps(r, r));
+        return _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(1.5f), halfVRR));
+      }
+
+      // Per-lane state of the separating axis test
+      struct SATLanes {
+        __m128 separated = _mm_setzero_ps();
+        __m128 bestDepth = _mm_set1_ps(FLT_MAX);
+        __m128 bestAxis  = _mm_setzero_ps();
+        __m128 bestSign  = _mm_set1_ps(1.0f);
+
+        // 'radius' is the sum of both projected half sizes, 'distance' the signed projected center distance and
+        // 'invLength' rescales both to world units for the non-normalized cross axes. Lanes outside 'candidate'
+        // still count for separation but never become the best axis.
+        inline void Test(float axisId, __m128 radius, __m128 distance, __m128 invLength, __m128 candidate) {
+          __m128 depth = _mm_sub_ps(radius, Abs(distance));
+          separated    = _mm_or_ps(separated, _mm_cmplt_ps(depth, _mm_setzero_ps()));
+
+          depth         = _mm_mul_ps(depth, invLength);
+          __m128 better = _mm_and_ps(candidate, _mm_cmplt_ps(depth, bestDepth));
+          bestDepth     = Select(better, depth, bestDepth);
+          bestAxis      = Select(better, _mm_set1_ps(axisId), bestAxis);
+          bestSign      = Select(better, _mm_or_ps(_mm_and_ps(distance, _mm_set1_ps(-0.0f)), _mm_set1_ps(1.0f)),
+                                 bestSign);
+        }
+      };
+    }  // namespace details
+
+    // Oriented box in the layout the batch kernel consumes
+    struct OBB {
+      // World-space center
+      float Center[3];
+      // World-space unit axes, Axes[i] is the local axis 'i'
+      float Axes[3][3];
+      // Half dimensions along each axis
+      float HalfDimensions[3];
+
+      OBB() : Center{}, Axes{{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}}, HalfDimensions{} {}
+
+      // Primitive of a body at 'bodyOrientation' and 'bodyPosition'
+      OBB(const RigidBody::Primitive& primitive, const UMath::Vector4& bodyOrientation,
+          const UMath::Vector3& bodyPosition) {
+        const float body[4] = {bodyOrientation.x, bodyOrientation.y, bodyOrientation.z, bodyOrientation.w};
+        const float prim[4] = {primitive.mOrientation.x, primitive.mOrientation.y, primitive.mOrientation.z,
+                               primitive.mOrientation.w};
+        float       world[4];
+        details::MultiplyQuaternion(body, prim, world);
+        details::QuaternionToAxes(world[0], world[1], world[2], world[3], Axes);
+
+        float bodyAxes[3][3];
+        details::QuaternionToAxes(body[0], body[1], body[2], body[3], bodyAxes);
+        const float offset[3] = {primitive.mOffset.x, primitive.mOffset.y, primitive.mOffset.z};
+        Center[0]             = bodyPosition.x;
+        Center[1]             = bodyPosition.y;
+        Center[2]             = bodyPosition.z;
+        for (std::size_t i = 0; i < 3; i++)
+          for (std::size_t k = 0; k < 3; k++) Center[k] += bodyAxes[i][k] * offset[i];
+
+        HalfDimensions[0] = primitive.mDimension.x;
+        HalfDimensions[1] = primitive.mDimension.y;
+        HalfDimensions[2] = primitive.mDimension.z;
+      }
+
+      // Collision bounds node, in the space of its owner
+      OBB(CollisionGeometry::Bounds bounds) {
+        UMath::Vector4 orientation;
+        UMath::Vector3 position;
+        UMath::Vector3 half_dimensions;
+        bounds.GetOrientation(orientation);
+        bounds.GetPosition(position);
+        bounds.GetHalfDimensions(half_dimensions);
+
+        float q[4] = {orientation.x, orientation.y, orientation.z, orientation.w};
+        float len  = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+        if (len > 0.0f)
+          for (auto& c : q) c /= len;
+        else
+          q[3] = 1.0f;
+        details::QuaternionToAxes(q[0], q[1], q[2], q[3], Axes);
+
+        Center[0]         = position.x;
+        Center[1]         = position.y;
+        Center[2]         = position.z;
+        HalfDimensions[0] = half_dimensions.x;
+        HalfDimensions[1] = half_dimensions.y;
+        HalfDimensions[2] = half_dimensions.z;
+      }
+
+      // Box part of an existing collision geometry
+      OBB(const Dynamics::Collision::Geometry& geometry) {
+        Center[0] = geometry.mPosition.x;
+        Center[1] = geometry.mPosition.y;
+        Center[2] = geometry.mPosition.z;
+        for (std::size_t i = 0; i < 3; i++) {
+          Axes[i][0]        = geometry.mNormal[i].x;
+          Axes[i][1]        = geometry.mNormal[i].y;
+          Axes[i][2]        = geometry.mNormal[i].z;
+          HalfDimensions[i] = geometry.mDimension[i];
+        }
+      }
+
+      // Fill the box part of a collision geometry, collision results are cleared
+      void ToGeometry(Dynamics::Collision::Geometry& to) const {
+        to.mPosition = UMath::Vector4(Center[0], Center[1], Center[2], 1.0f);
+        for (std::size_t i = 0; i < 3; i++) {
+          to.mNormal[i]    = UMath::Vector4(Axes[i][0], Axes[i][1], Axes[i][2], 0.0f);
+          to.mExtent[i]    = to.mNormal[i] * HalfDimensions[i];
+          to.mDimension[i] = HalfDimensions[i];
+        }
+        to.mCollision_point  = UMath::Vector4();
+        to.mCollision_normal = UMath::Vector4();
+        to.mShape            = 0;
+        to.mPenetratesOther  = 0;
+        to.mDelta            = UMath::Vector3();
+        to.mOverlap          = 0.0f;
+      }
+    };
+
+    // Many OBBs stored as structure-of-arrays, padded to the SSE width
+    class OBBBatch {
+      // [center xyz, axis0 xyz, axis1 xyz, axis2 xyz, half dimensions xyz]
+      std::vector<float> mData[15];
+      std::size_t        mCount;
+
+     public:
+      OBBBatch() : mCount(0) {}
+      explicit OBBBatch(std::size_t reserve) : OBBBatch() { Reserve(reserve); }
+
+      std::size_t GetCount() const { return mCount; }
+      const float* GetColumn(std::size_t idx) const { return mData[idx].data(); }
+
+      void Reserve(std::size_t count) {
+        for (auto& column : mData) column.reserve((count + 3) & ~std::size_t(3));
+      }
+      void Clear() {
+        for (auto& column : mData) column.clear();
+        mCount = 0;
+      }
+
+      void Add(const OBB& obb) {
+        // Grow by a whole SSE lane group so the kernel never reads past the end
+        if ((mCount & 3) == 0)
+          for (auto& column : mData) column.resize(mCount + 4, 0.0f);
+
+        for (std::size_t k = 0; k < 3; k++) {
+          mData[k][mCount]      = obb.Center[k];
+          mData[3 + k][mCount]  = obb.Axes[0][k];
+          mData[6 + k][mCount]  = obb.Axes[1][k];
+          mData[9 + k][mCount]  = obb.Axes[2][k];
+          mData[12 + k][mCount] = obb.HalfDimensions[k];
+        }
+        mCount++;
+      }
+
+      OBB Get(std::size_t idx) const {
+        OBB obb;
+        for (std::size_t k = 0; k < 3; k++) {
+          obb.Center[k]         = mData[k][idx];
+          obb.Axes[0][k]        = mData[3 + k][idx];
+          obb.Axes[1][k]        = mData[6 + k][idx];
+          obb.Axes[2][k]        = mData[9 + k][idx];
+          obb.HalfDimensions[k] = mData[12 + k][idx];
+        }
+        return obb;
+      }
+    };
+
+    // Test 'obb' against every box in 'batch' with the separating axis theorem, 4 boxes per iteration.
+    // For each box 'i', 'results[i]' gets mPenetratesOther (0/1), mOverlap (penetration depth), mCollision_normal
+    // (unit, pointing from 'obb' towards the box) and mCollision_point (deepest point of the box); other fields are
+    // left untouched. Returns the amount of intersecting boxes.
+    static std::size_t FindIntersections(const OBB& obb, const OBBBatch& batch, Dynamics::Collision::Geometry* results) {
+      constexpr float kParallelEpsilon = 1e-6f;
+
+      std::size_t hits = 0;
+      for (std::size_t base = 0; base < batch.GetCount(); base += 4) {
+        __m128 b[15];
+        for (std::size_t c = 0; c < 15; c++) b[c] = _mm_loadu_ps(batch.GetColumn(c) + base);
+
+        // Center offset
+        __m128 d[3];
+        for (std::size_t k = 0; k < 3; k++) d[k] = _mm_sub_ps(b[k], _mm_set1_ps(obb.Center[k]));
+
+        // Rotation and translation expressed in the frame of 'obb'
+        __m128 R[3][3], AbsR[3][3], t[3];
+        for (std::size_t i = 0; i < 3; i++) {
+          const __m128 ax = _mm_set1_ps(obb.Axes[i][0]);
+          const __m128 ay = _mm_set1_ps(obb.Axes[i][1]);
+          const __m128 az = _mm_set1_ps(obb.Axes[i][2]);
+          t[i] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, d[0]), _mm_mul_ps(ay, d[1])), _mm_mul_ps(az, d[2]));
+          for (std::size_t j = 0; j < 3; j++) {
+            const __m128* u = &b[3 + j * 3];
+            R[i][j] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, u[0]), _mm_mul_ps(ay, u[1])), _mm_mul_ps(az, u[2]));
+            // Epsilon keeps near-parallel cross axes from reporting false separations
+            AbsR[i][j] = _mm_add_ps(details::Abs(R[i][j]), _mm_set1_ps(kParallelEpsilon));
+          }
+        }
+
+        const __m128* e = &b[12];
+        const __m128  one = _mm_set1_ps(1.0f);
+        const __m128  all = _mm_cmpeq_ps(one, one);
+        __m128        ea[3];
+        for (std::size_t i = 0; i < 3; i++) ea[i] = _mm_set1_ps(obb.HalfDimensions[i]);
+
+        details::SATLanes lanes;
+        // Axes of 'obb'
+        for (std::size_t i = 0; i < 3; i++) {
+          __m128 rb = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e[0], AbsR[i][0]), _mm_mul_ps(e[1], AbsR[i][1])),
+                                 _mm_mul_ps(e[2], AbsR[i][2]));
+          lanes.Test(static_cast<float>(i), _mm_add_ps(ea[i], rb), t[i], one, all);
+        }
+        // Axes of the batch boxes
+        for (std::size_t j = 0; j < 3; j++) {
+          __m128 ra = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ea[0], AbsR[0][j]), _mm_mul_ps(ea[1], AbsR[1][j])),
+                                 _mm_mul_ps(ea[2], AbsR[2][j]));
+          __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(t[0], R[0][j]), _mm_mul_ps(t[1], R[1][j])),
+                                       _mm_mul_ps(t[2], R[2][j]));
+          lanes.Test(static_cast<float>(3 + j), _mm_add_ps(ra, e[j]), distance, one, all);
+        }
+        // Cross products of both axis sets
+        for (std::size_t i = 0; i < 3; i++) {
+          const std::size_t i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+          for (std::size_t j = 0; j < 3; j++) {
+            const std::size_t j1 = (j + 1) % 3, j2 = (j + 2) % 3;
+
+            __m128 ra = _mm_add_ps(_mm_mul_ps(ea[i1], AbsR[i2][j]), _mm_mul_ps(ea[i2], AbsR[i1][j]));
+            __m128 rb = _mm_add_ps(_mm_mul_ps(e[j1], AbsR[i][j2]), _mm_mul_ps(e[j2], AbsR[i][j1]));
+            __m128 distance = _mm_sub_ps(_mm_mul_ps(t[i2], R[i1][j]), _mm_mul_ps(t[i1], R[i2][j]));
+
+            // |Ai x Bj| = sin(angle), degenerate axes are masked out of the contact normal selection
+            __m128 sin_sq    = _mm_sub_ps(one, _mm_mul_ps(R[i][j], R[i][j]));
+            __m128 valid     = _mm_cmpgt_ps(sin_sq, _mm_set1_ps(kParallelEpsilon));
+            __m128 invLength = details::InvSqrt(_mm_max_ps(sin_sq, _mm_set1_ps(kParallelEpsilon)));
+            lanes.Test(static_cast<float>(6 + i * 3 + j), _mm_add_ps(ra, rb), distance, invLength, valid);
+          }
+        }
+
+        const int         separated = _mm_movemask_ps(lanes.separated);
+        alignas(16) float depth[4], axis[4], sign[4];
+        _mm_store_ps(depth, lanes.bestDepth);
+        _mm_store_ps(axis, lanes.bestAxis);
+        _mm_store_ps(sign, lanes.bestSign);
+
+        const std::size_t lane_count = std::min<std::size_t>(4, batch.GetCount() - base);
+        for (std::size_t lane = 0; lane < lane_count; lane++) {
+          auto& result = results[base + lane];
+          if (separated & (1 << lane)) {
+            result.mPenetratesOther = 0;
+            result.mOverlap         = 0.0f;
+            continue;
+          }
+
+          const OBB   other = batch.Get(base + lane);
+          const auto  id    = static_cast<std::size_t>(axis[lane]);
+          float       n[3];
+          if (id < 3) {
+            for (std::size_t k = 0; k < 3; k++) n[k] = obb.Axes[id][k];
+          } else if (id < 6) {
+            for (std::size_t k = 0; k < 3; k++) n[k] = other.Axes[id - 3][k];
+          } else {
+            const float* a = obb.Axes[(id - 6) / 3];
+            const float* u = other.Axes[(id - 6) % 3];
+            n[0]           = a[1] * u[2] - a[2] * u[1];
+            n[1]           = a[2] * u[0] - a[0] * u[2];
+            n[2]           = a[0] * u[1] - a[1] * u[0];
+            float len      = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+            for (auto& c : n) c /= len;
+          }
+          for (auto& c : n) c *= sign[lane];
+
+          // Deepest vertex of the other box along the normal
+          float point[3] = {other.Center[0], other.Center[1], other.Center[2]};
+          for (std::size_t j = 0; j < 3; j++) {
+            float along = n[0] * other.Axes[j][0] + n[1] * other.Axes[j][1] + n[2] * other.Axes[j][2];
+            float h     = along > 0.0f ? -other.HalfDimensions[j] : other.HalfDimensions[j];
+            for (std::size_t k = 0; k < 3; k++) point[k] += other.Axes[j][k] * h;
+          }
+
+          result.mPenetratesOther  = 1;
+          result.mOverlap          = depth[lane];
+          result.mCollision_normal = UMath::Vector4(n[0], n[1], n[2], 0.0f);
+          result.mCollision_point  = UMath::Vector4(point[0], point[1], point[2], 1.0f);
+          hits++;
+        }
+      }
+      return hits;
+    }
+  }  // namespace CollisionEx
+
   //        //
   // IInput //
   //        //
@@ -337,12 +1056,8 @@ namespace OpenSpeed::MW05 {
 
       struct PInputCast_t {
         PInput* operator()(IInput* iInput) const {
-          if (!iInput || !MemoryEditor::Get().ValidateMemoryIsInitialized(iInput)) return nullptr;
-          // Verify cast
           auto* pi = static_cast<PInput*>(iInput);
-          if (*reinterpret_cast<std::uintptr_t*>(pi) == 0x8AB598) return pi;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(pi, TypeInfoEx::kPInput) ? pi : nullptr;
         }
       };
       static PInput* operator|(IInput* iInput, PInputCast_t ext) { return ext(iInput); }
@@ -353,12 +1068,8 @@ namespace OpenSpeed::MW05 {
 
       struct InputPlayerCast_t {
         InputPlayer* operator()(IInput* iInput) const {
-          if (!iInput || !MemoryEditor::Get().ValidateMemoryIsInitialized(iInput)) return nullptr;
-          // Verify cast
           auto* ip = static_cast<InputPlayer*>(iInput);
-          if (*reinterpret_cast<std::uintptr_t*>(ip) == 0x8AC6BC) return ip;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ip, TypeInfoEx::kInputPlayer) ? ip : nullptr;
         }
       };
       static InputPlayer* operator|(IInput* iInput, InputPlayerCast_t ext) { return ext(iInput); }
@@ -393,12 +1104,8 @@ namespace OpenSpeed::MW05 {
 
       struct AIVehicleCast_t {
         AIVehicle* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicle*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x891A80) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicle) ? ai : nullptr;
         }
       };
       static AIVehicle* operator|(IVehicleAI* i, AIVehicleCast_t ext) { return ext(i); }
@@ -409,12 +1116,8 @@ namespace OpenSpeed::MW05 {
 
       struct AIVehicleCopCarCast_t {
         AIVehicleCopCar* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleCopCar*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x892560) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleCopCar) ? ai : nullptr;
         }
       };
       static AIVehicleCopCar* operator|(IVehicleAI* i, AIVehicleCopCarCast_t ext) { return ext(i); }
@@ -425,12 +1128,8 @@ namespace OpenSpeed::MW05 {
 
       struct AIVehicleEmptyCast_t {
         AIVehicleEmpty* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleEmpty*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x892E28) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleEmpty) ? ai : nullptr;
         }
       };
       static AIVehicleEmpty* operator|(IVehicleAI* iAI, AIVehicleEmptyCast_t ext) { return ext(iAI); }
@@ -441,12 +1140,8 @@ namespace OpenSpeed::MW05 {
 
       struct AIVehicleHelicopterCast_t {
         AIVehicleHelicopter* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleHelicopter*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x8920D8) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleHelicopter) ? ai : nullptr;
         }
       };
       static AIVehicleHelicopter* operator|(IVehicleAI* i, AIVehicleHelicopterCast_t ext) { return ext(i); }
@@ -457,12 +1152,8 @@ namespace OpenSpeed::MW05 {
 
       struct AIVehicleHumanCast_t {
         AIVehicleHuman* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleHuman*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x892AD0) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleHuman) ? ai : nullptr;
         }
       };
       static AIVehicleHuman* operator|(IVehicleAI* i, AIVehicleHumanCast_t ext) { return ext(i); }
@@ -473,12 +1164,8 @@ namespace OpenSpeed::MW05 {
 
       struct AIVehiclePidCast_t {
         AIVehiclePid* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehiclePid*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x891BB8) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehiclePid) ? ai : nullptr;
         }
       };
       static AIVehiclePid* operator|(IVehicleAI* i, AIVehiclePidCast_t ext) { return ext(i); }
@@ -489,12 +1176,8 @@ namespace OpenSpeed::MW05 {
 
       struct AIVehiclePursuitCast_t {
         AIVehiclePursuit* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehiclePursuit*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x891EC0) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehiclePursuit) ? ai : nullptr;
         }
       };
       static AIVehiclePursuit* operator|(IVehicleAI* i, AIVehiclePursuitCast_t ext) { return ext(i); }
@@ -505,12 +1188,8 @@ namespace OpenSpeed::MW05 {
 
       struct AIVehicleRacecarCast_t {
         AIVehicleRacecar* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleRacecar*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x892720) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleRacecar) ? ai : nullptr;
         }
       };
       static AIVehicleRacecar* operator|(IVehicleAI* i, AIVehicleRacecarCast_t ext) { return ext(i); }
@@ -521,12 +1200,8 @@ namespace OpenSpeed::MW05 {
 
       struct AIVehicleTrafficCast_t {
         AIVehicleTraffic* operator()(IVehicleAI* iAI) const {
-          if (!iAI || !MemoryEditor::Get().ValidateMemoryIsInitialized(iAI)) return nullptr;
-          // Verify cast
           auto* ai = static_cast<AIVehicleTraffic*>(iAI);
-          if (*reinterpret_cast<std::uintptr_t*>(ai) == 0x891CF8) return ai;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(ai, TypeInfoEx::kAIVehicleTraffic) ? ai : nullptr;
         }
       };
       static AIVehicleTraffic* operator|(IVehicleAI* i, AIVehicleTrafficCast_t ext) { return ext(i); }
@@ -589,22 +1264,8 @@ namespace OpenSpeed::MW05 {
 
       struct DamageVehicleCast_t {
         DamageVehicle* operator()(IDamageable* iDamageable) const {
-          if (!iDamageable || !MemoryEditor::Get().ValidateMemoryIsInitialized(iDamageable)) return nullptr;
-          // Verify cast
           auto* damageable = static_cast<DamageVehicle*>(iDamageable);
-          auto  vfptr      = *reinterpret_cast<std::uintptr_t*>(damageable);
-          // type: DamageVehicle
-          if (vfptr == 0x8AD2CC) return damageable;
-          // type: DamageCopCar
-          if (vfptr == 0x8AD438) return damageable;
-          // type: DamageHeli
-          if (vfptr == 0x8AD3C4) return damageable;
-          // type: DamageRacer
-          if (vfptr == 0x8AD350) return damageable;
-          // type: DamageDragster
-          if (vfptr == 0x8AD6AC) return damageable;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(damageable, TypeInfoEx::kDamageVehicle) ? damageable : nullptr;
         }
       };
       static DamageVehicle* operator|(IDamageable* i, DamageVehicleCast_t ext) { return ext(i); }
@@ -615,12 +1276,8 @@ namespace OpenSpeed::MW05 {
 
       struct DamageCopCarCast_t {
         DamageCopCar* operator()(IDamageable* iDamageable) const {
-          if (!iDamageable || !MemoryEditor::Get().ValidateMemoryIsInitialized(iDamageable)) return nullptr;
-          // Verify cast
           auto* damageable = static_cast<DamageCopCar*>(iDamageable);
-          if (*reinterpret_cast<std::uintptr_t*>(damageable) == 0x8AD438) return damageable;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(damageable, TypeInfoEx::kDamageCopCar) ? damageable : nullptr;
         }
       };
       static DamageCopCar* operator|(IDamageable* i, DamageCopCarCast_t ext) { return ext(i); }
@@ -631,12 +1288,8 @@ namespace OpenSpeed::MW05 {
 
       struct DamageHeliCast_t {
         DamageHeli* operator()(IDamageable* iDamageable) const {
-          if (!iDamageable || !MemoryEditor::Get().ValidateMemoryIsInitialized(iDamageable)) return nullptr;
-          // Verify cast
           auto* damageable = static_cast<DamageHeli*>(iDamageable);
-          if (*reinterpret_cast<std::uintptr_t*>(damageable) == 0x8AD3C4) return damageable;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(damageable, TypeInfoEx::kDamageHeli) ? damageable : nullptr;
         }
       };
       static DamageHeli* operator|(IDamageable* i, DamageHeliCast_t ext) { return ext(i); }
@@ -647,16 +1300,8 @@ namespace OpenSpeed::MW05 {
 
       struct DamageRacerCast_t {
         DamageRacer* operator()(IDamageable* iDamageable) const {
-          if (!iDamageable || !MemoryEditor::Get().ValidateMemoryIsInitialized(iDamageable)) return nullptr;
-          // Verify cast
           auto* damageable = static_cast<DamageRacer*>(iDamageable);
-          auto  vfptr      = *reinterpret_cast<std::uintptr_t*>(damageable);
-          // type: DamageRacer
-          if (vfptr == 0x8AD350) return damageable;
-          // type: DamageDragster
-          if (vfptr == 0x8AD6AC) return damageable;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(damageable, TypeInfoEx::kDamageRacer) ? damageable : nullptr;
         }
       };
       static DamageRacer* operator|(IDamageable* i, DamageRacerCast_t ext) { return ext(i); }
@@ -667,12 +1312,8 @@ namespace OpenSpeed::MW05 {
 
       struct DamageDragsterCast_t {
         DamageDragster* operator()(IDamageable* iDamageable) const {
-          if (!iDamageable || !MemoryEditor::Get().ValidateMemoryIsInitialized(iDamageable)) return nullptr;
-          // Verify cast
           auto* damageable = static_cast<DamageDragster*>(iDamageable);
-          if (*reinterpret_cast<std::uintptr_t*>(damageable) == 0x8AD6AC) return damageable;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(damageable, TypeInfoEx::kDamageDragster) ? damageable : nullptr;
         }
       };
       static DamageDragster* operator|(IDamageable* i, DamageDragsterCast_t ext) { return ext(i); }
@@ -719,11 +1360,7 @@ namespace OpenSpeed::MW05 {
 
       struct ValidatePlayer_t {
         IPlayer* operator()(IPlayer* player) const {
-          if (!player || !MemoryEditor::Get().ValidateMemoryIsInitialized(player)) return nullptr;
-          // LocalPlayer
-          if (*reinterpret_cast<std::uintptr_t*>(player) == 0x8B0B10) return player;
-          // Bad ptr
-          return nullptr;
+          return TypeInfoEx::Is(player, TypeInfoEx::kPlayer) ? player : nullptr;
         }
       };
       static IPlayer* operator|(IPlayer* player, ValidatePlayer_t ext) { return ext(player); }
@@ -734,13 +1371,8 @@ namespace OpenSpeed::MW05 {
 
       struct LocalPlayerCast_t {
         LocalPlayer* operator()(IPlayer* player) const {
-          if (!player || !MemoryEditor::Get().ValidateMemoryIsInitialized(player)) return nullptr;
-          // Verify cast
           auto* local_player = static_cast<LocalPlayer*>(player);
-          // LocalPlayer
-          if (*reinterpret_cast<std::uintptr_t*>(local_player) == 0x8B0BB0) return local_player;
-          // Bad cast
-          return nullptr;
+          return TypeInfoEx::Is(local_player, TypeInfoEx::kLocalPlayer) ? local_player : nullptr;
         }
       };
       static LocalPlayer* operator|(IPlayer* i, LocalPlayerCast_t ext) { return ext(i); }
@@ -763,4 +1395,737 @@ namespace OpenSpeed::MW05 {
     }
   }  // namespace PlayerEx
 
+  //                //
+  // Frame snapshot //
+  //                //
+
+  namespace FrameSnapshotEx {
+    // Snapshot capacities, anything past these is left out of the snapshot
+    static constexpr std::size_t kMaxVehicles = 64;
+    static constexpr std::size_t kMaxBodies   = 128;
+    static constexpr std::size_t kMaxRacers   = 16;
+    static constexpr std::size_t kMaxCops     = 32;
+    static constexpr std::size_t kMaxPursuits = 8;
+
+    namespace details {
+      // Position/velocity columns of a RigidBody::Volatile or SimpleRigidBody::Volatile list
+      template <typename Volatile>
+      struct BodyColumns {
+        alignas(64) Volatile* mInstance[kMaxBodies];
+        alignas(64) float mPositionX[kMaxBodies];
+        alignas(64) float mPositionY[kMaxBodies];
+        alignas(64) float mPositionZ[kMaxBodies];
+        alignas(64) float mVelocityX[kMaxBodies];
+        alignas(64) float mVelocityY[kMaxBodies];
+        alignas(64) float mVelocityZ[kMaxBodies];
+        std::size_t mCount = 0;
+
+        bool Add(Volatile* volatileData) {
+          if (mCount == kMaxBodies) return false;
+
+          const auto i  = mCount++;
+          mInstance[i]  = volatileData;
+          mPositionX[i] = volatileData->position.x;
+          mPositionY[i] = volatileData->position.y;
+          mPositionZ[i] = volatileData->position.z;
+          mVelocityX[i] = volatileData->linearVelocity.x;
+          mVelocityY[i] = volatileData->linearVelocity.y;
+          mVelocityZ[i] = volatileData->linearVelocity.z;
+          return true;
+        }
+      };
+    }  // namespace details
+
+    // Hot PVehicle fields, one column per field
+    struct VehicleColumns {
+      alignas(64) PVehicle* mInstance[kMaxVehicles];
+      alignas(64) HSIMABLE__* mHandle[kMaxVehicles];
+      alignas(64) float mPositionX[kMaxVehicles];
+      alignas(64) float mPositionY[kMaxVehicles];
+      alignas(64) float mPositionZ[kMaxVehicles];
+      alignas(64) float mVelocityX[kMaxVehicles];
+      alignas(64) float mVelocityY[kMaxVehicles];
+      alignas(64) float mVelocityZ[kMaxVehicles];
+      // Angular velocity around the up (Z) axis
+      alignas(64) float mYawRate[kMaxVehicles];
+      alignas(64) float mSpeed[kMaxVehicles];
+      alignas(64) DriverClass mDriverClass[kMaxVehicles];
+      std::size_t mCount = 0;
+    };
+
+    struct RacerColumns {
+      alignas(64) HSIMABLE__* mHandle[kMaxRacers];
+      // Index into VehicleColumns, -1 if the racer has no live vehicle
+      alignas(64) std::int32_t mVehicleIndex[kMaxRacers];
+      alignas(64) std::int32_t mRanking[kMaxRacers];
+      alignas(64) float mPctRaceComplete[kMaxRacers];
+      // Knocked out, totalled, busted or finished
+      alignas(64) bool mIsOut[kMaxRacers];
+      std::size_t mCount = 0;
+    };
+
+    struct CopColumns {
+      alignas(64) PVehicle* mInstance[kMaxCops];
+      alignas(64) IPursuit* mPursuits[kMaxPursuits];
+      std::size_t  mCount             = 0;
+      std::size_t  mPursuitCount      = 0;
+      std::int32_t mActiveCars        = 0;
+      std::int32_t mActiveHelicopters = 0;
+    };
+
+    // Everything mods read about the world in a frame, captured and validated once.
+    // Pointers are only good until the game ticks again, so call Capture() at the start of every frame.
+    // Usage: const auto& snapshot = FrameSnapshotEx::Get(); if (auto* player = snapshot.GetPlayerInstance()) ...
+    class Snapshot {
+      VehicleColumns                                  mVehicles;
+      details::BodyColumns<RigidBody::Volatile>       mRigidBodies;
+      details::BodyColumns<SimpleRigidBody::Volatile> mSimpleBodies;
+      RacerColumns                                    mRacers;
+      CopColumns                                      mCops;
+      std::int32_t                                    mPlayerIndex = -1;
+      bool                                            mIsRacing    = false;
+      std::uint32_t                                   mFrame       = 0;
+
+      void CaptureVehicles() {
+        mVehicles.mCount = 0;
+        mPlayerIndex     = -1;
+        PVehicleEx::ForEachInstance([this](PVehicle* pvehicle) {
+          if (mVehicles.mCount == kMaxVehicles) return false;
+
+          const auto     i        = mVehicles.mCount++;
+          const auto&    position = pvehicle->GetPosition();
+          UMath::Vector3 velocity, angular_velocity;
+          pvehicle->GetLinearVelocity(velocity);
+          pvehicle->GetAngularVelocity(angular_velocity);
+
+          mVehicles.mInstance[i]    = pvehicle;
+          mVehicles.mHandle[i]      = pvehicle->GetOwnerHandle();
+          mVehicles.mPositionX[i]   = position.x;
+          mVehicles.mPositionY[i]   = position.y;
+          mVehicles.mPositionZ[i]   = position.z;
+          mVehicles.mVelocityX[i]   = velocity.x;
+          mVehicles.mVelocityY[i]   = velocity.y;
+          mVehicles.mVelocityZ[i]   = velocity.z;
+          mVehicles.mYawRate[i]     = angular_velocity.z;
+          mVehicles.mSpeed[i]       = pvehicle->mSpeed;
+          mVehicles.mDriverClass[i] = pvehicle->mDriverClass;
+          if (mPlayerIndex < 0 && pvehicle->IsPlayer() && pvehicle->IsOwnedByPlayer())
+            mPlayerIndex = static_cast<std::int32_t>(i);
+          return true;
+        });
+      }
+
+      void CaptureBodies() {
+        mRigidBodies.mCount  = 0;
+        mSimpleBodies.mCount = 0;
+        RigidBodyEx::ForEachInstance(
+            [this](RigidBody::Volatile* volatileData) { return mRigidBodies.Add(volatileData); });
+        SimpleBodyEx::ForEachInstance(
+            [this](SimpleRigidBody::Volatile* volatileData) { return mSimpleBodies.Add(volatileData); });
+      }
+
+      void CaptureRacers() {
+        mRacers.mCount = 0;
+        mIsRacing      = false;
+
+        auto* race_status = GRaceStatus::Get();
+        if (!race_status || !MemoryEditor::Get().ValidateMemoryIsInitialized(race_status)) return;
+
+        mIsRacing        = race_status->mPlayMode == GRaceStatus::PlayMode::Racing;
+        const auto count = std::min<std::size_t>(std::max(race_status->mRacerCount, 0), kMaxRacers);
+        for (std::size_t i = 0; i < count; i++) {
+          const auto& racer           = race_status->mRacerInfo[i];
+          mRacers.mHandle[i]          = racer.mhSimable;
+          mRacers.mVehicleIndex[i]    = FindVehicleIndex(racer.mhSimable);
+          mRacers.mRanking[i]         = racer.mRanking;
+          mRacers.mPctRaceComplete[i] = racer.mPctRaceComplete;
+          mRacers.mIsOut[i]           = racer.mKnockedOut || racer.mTotalled || racer.mBusted || racer.mFinishedRacing;
+        }
+        mRacers.mCount = count;
+      }
+
+      void CaptureCops() {
+        mCops                 = {};
+        AICopManager* cop_mgr = Variables::TheOneCopManager;
+        if (!cop_mgr || !MemoryEditor::Get().ValidateMemoryIsInitialized(cop_mgr)) return;
+
+        mCops.mActiveCars        = cop_mgr->mNumActiveCopCars;
+        mCops.mActiveHelicopters = cop_mgr->mNumActiveCopHelicopters;
+
+        for (auto* ivehicle : UTLView::View(cop_mgr->mIVehicleList)) {
+          if (mCops.mCount == kMaxCops) break;
+          if (auto* pvehicle = ivehicle ? static_cast<PVehicle*>(ivehicle) | PVehicleEx::ValidatePVehicle : nullptr)
+            mCops.mInstance[mCops.mCount++] = pvehicle;
+        }
+        for (auto* pursuit : cop_mgr->mIPursuitList) {
+          if (mCops.mPursuitCount == kMaxPursuits) break;
+          mCops.mPursuits[mCops.mPursuitCount++] = pursuit;
+        }
+      }
+
+     public:
+      // Walk every instance list once and copy out the hot fields
+      void Capture() {
+        CaptureVehicles();
+        CaptureBodies();
+        CaptureRacers();
+        CaptureCops();
+        mFrame = FrameEx::GetFrame();
+      }
+
+      // FrameEx frame this snapshot was captured in
+      std::uint32_t GetFrame() const { return mFrame; }
+      bool          IsRacing() const { return mIsRacing; }
+
+      const VehicleColumns&                                  GetVehicles() const { return mVehicles; }
+      const details::BodyColumns<RigidBody::Volatile>&       GetRigidBodies() const { return mRigidBodies; }
+      const details::BodyColumns<SimpleRigidBody::Volatile>& GetSimpleBodies() const { return mSimpleBodies; }
+      const RacerColumns&                                    GetRacers() const { return mRacers; }
+      const CopColumns&                                      GetCops() const { return mCops; }
+
+      // Same as PVehicleEx::GetPlayerInstance() without rescanning
+      PVehicle* GetPlayerInstance() const { return mPlayerIndex < 0 ? nullptr : mVehicles.mInstance[mPlayerIndex]; }
+      std::int32_t GetPlayerIndex() const { return mPlayerIndex; }
+
+      // Index into GetVehicles() of the vehicle owned by a handle, -1 if it wasn't captured
+      std::int32_t FindVehicleIndex(HSIMABLE__* handle) const {
+        if (!handle) return -1;
+        for (std::size_t i = 0; i < mVehicles.mCount; i++)
+          if (mVehicles.mHandle[i] == handle) return static_cast<std::int32_t>(i);
+
+        return -1;
+      }
+    };
+
+    static inline Snapshot g_mSnapshot;
+
+    // Start a new frame and capture its snapshot, call it once from the main loop hook instead of FrameEx::NextFrame()
+    static void Capture() {
+      FrameEx::NextFrame();
+      g_mSnapshot.Capture();
+    }
+    // The snapshot taken by the last Capture()
+    static const Snapshot& Get() { return g_mSnapshot; }
+  }  // namespace FrameSnapshotEx
+
+  //            //
+  // Trajectory //
+  //            //
+
+  namespace TrajectoryEx {
+    // Up to 128 points ahead, e.g. 4 seconds at 30 points per second
+    static constexpr std::size_t kMaxSteps = 128;
+
+    using Model     = TrajectoryPredictor::Model;
+    using Predictor = TrajectoryPredictor::Predictor<FrameSnapshotEx::kMaxVehicles, kMaxSteps>;
+
+    namespace details {
+      static inline Predictor g_mPredictor;
+      // Two workers plus the game thread; overlays need little, and more threads would compete with the game's own
+      static inline std::unique_ptr<WorkerPool::Pool> g_mPool;
+
+      // The nav's lane segment, assuming its control points are absolute positions like its end points
+      static bool AddRoad(TrajectoryPredictor::Path& path, const WRoadNav& nav) {
+        if (!nav.fValid) return false;
+
+        const float p0[3] = {nav.fStartPos.x, nav.fStartPos.y, nav.fStartPos.z};
+        const float c0[3] = {nav.fStartControl.x, nav.fStartControl.y, nav.fStartControl.z};
+        const float c1[3] = {nav.fEndControl.x, nav.fEndControl.y, nav.fEndControl.z};
+        const float p1[3] = {nav.fEndPos.x, nav.fEndPos.y, nav.fEndPos.z};
+        return path.AddBezier(p0, c0, c1, p1);
+      }
+
+      // Current then future road of the vehicle's AI, -1 if it has neither
+      static std::int32_t AddPath(PVehicle* pvehicle) {
+        auto* ai = pvehicle->mAI | AIVehicleEx::AsAIVehicle;
+        if (!ai) return -1;
+
+        std::int32_t idx  = -1;
+        auto*        path = g_mPredictor.AddPath(idx);
+        if (!path) return -1;
+
+        AddRoad(*path, ai->mCurrentRoad);
+        AddRoad(*path, ai->mFutureRoad);
+        return path->IsValid() ? idx : -1;
+      }
+    }  // namespace details
+
+    // Predict every vehicle of the current FrameSnapshotEx snapshot 'steps' points of 'stepTime' ahead, on the game
+    // thread after FrameSnapshotEx::Capture(). Model::Path follows each AI's current and future road and falls back
+    // to Model::ConstantTurnRate without one. The result indices match FrameSnapshotEx::Get().GetVehicles().
+    // Usage: auto& predictor = TrajectoryEx::Predict(TrajectoryEx::Model::Path); predictor.FindClosestApproach(...);
+    static const Predictor& Predict(Model model, float stepTime = 1.0f / 30.0f, std::size_t steps = 90) {
+      if (!details::g_mPool) details::g_mPool = std::make_unique<WorkerPool::Pool>(2);
+
+      auto&       predictor = details::g_mPredictor;
+      const auto& vehicles  = FrameSnapshotEx::Get().GetVehicles();
+      predictor.Clear();
+      for (std::size_t i = 0; i < vehicles.mCount; i++) {
+        TrajectoryPredictor::Vehicle vehicle = {
+            {vehicles.mPositionX[i], vehicles.mPositionY[i], vehicles.mPositionZ[i]},
+            {vehicles.mVelocityX[i], vehicles.mVelocityY[i], vehicles.mVelocityZ[i]},
+            vehicles.mYawRate[i],
+            model,
+            -1};
+        if (model == Model::Path) vehicle.mPath = details::AddPath(vehicles.mInstance[i]);
+
+        predictor.Add(vehicle);
+      }
+
+      predictor.Predict(stepTime, steps, details::g_mPool.get());
+      return predictor;
+    }
+    // The last Predict() result
+    static const Predictor& Get() { return details::g_mPredictor; }
+  }  // namespace TrajectoryEx
+
+  //          //
+  // ISimable //
+  //          //
+
+  namespace SimableEx {
+    namespace details {
+      // HSIMABLE__* -> PVehicle, invalidated when FrameEx::GetFrame() moves on and refilled by Rebuild()
+      class HandleTable {
+        GenerationCache::Table<PVehicle*> mVehicles{256};
+        std::uint32_t                     mFrame = 0;
+
+        static std::uint64_t GetKey(HSIMABLE__* handle) { return reinterpret_cast<std::uintptr_t>(handle); }
+
+       public:
+        void Rebuild(const FrameSnapshotEx::Snapshot& snapshot) {
+          mVehicles.Invalidate();
+          mFrame = FrameEx::GetFrame();
+
+          const auto& vehicles = snapshot.GetVehicles();
+          for (std::size_t i = 0; i < vehicles.mCount; i++)
+            if (vehicles.mHandle[i]) mVehicles.Insert(GetKey(vehicles.mHandle[i]), vehicles.mInstance[i]);
+        }
+
+        // Hits are checked against the live vehicle, so one destroyed or reused since it was cached falls back to a
+        // scan like a miss does (e.g. vehicles spawned after Rebuild, props, the world). Handles with no vehicle are
+        // cached as nullptr until the frame changes.
+        PVehicle* Find(HSIMABLE__* handle) {
+          if (!handle) return nullptr;
+          if (mFrame != FrameEx::GetFrame()) {
+            mVehicles.Invalidate();
+            mFrame = FrameEx::GetFrame();
+          }
+
+          PVehicle* ret = nullptr;
+          if (mVehicles.Find(GetKey(handle), ret)) {
+            if (!ret) return nullptr;
+            if ((ret | PVehicleEx::ValidatePVehicle) && ret->GetOwnerHandle() == handle) return ret;
+            ret = nullptr;
+          }
+
+          const auto generation = mVehicles.GetGeneration();
+          PVehicleEx::ForEachInstance([&](PVehicle* pvehicle) {
+            if (pvehicle->GetOwnerHandle() == handle) ret = pvehicle;
+            return ret == nullptr;
+          });
+          mVehicles.Insert(GetKey(handle), ret, generation);
+          return ret;
+        }
+      };
+
+      static inline HandleTable g_mHandleTable;
+    }  // namespace details
+
+    // Refill the handle table from the current frame snapshot, call it right after FrameSnapshotEx::Capture()
+    static void RebuildHandleTable() { details::g_mHandleTable.Rebuild(FrameSnapshotEx::Get()); }
+
+    // Resolve a handle (GRacerInfo::mhSimable, Sim::Collision::Info::objA/objB, GetOwnerHandle()) to its PVehicle
+    // Usage: PVehicle* other = SimableEx::FindPVehicle(collisionInfo.objB);
+    static PVehicle* FindPVehicle(HSIMABLE__* handle) { return details::g_mHandleTable.Find(handle); }
+    // Same as FindPVehicle(), only vehicles are tracked
+    static ISimable* FindSimable(HSIMABLE__* handle) {
+      auto* pvehicle = FindPVehicle(handle);
+      if (pvehicle) return static_cast<ISimable*>(pvehicle);
+
+      return nullptr;
+    }
+  }  // namespace SimableEx
+
+  //          //
+  // GManager //
+  //          //
+
+  namespace GManagerEx {
+    // Stock car from GManager::mStockCars by its key, read through EASTLView so no game map code runs
+    // Usage: ISimable* car = GManagerEx::FindStockCar(key);
+    static ISimable* FindStockCar(std::uint32_t key) {
+      auto* manager = GManager::Get();
+      if (!manager) return nullptr;
+
+      const MemorySnapshot::LiveMemory                        memory;
+      EASTLView::Map<std::uint32_t, MemorySnapshot::Address>  stock_cars;
+      EASTLView::Pair<std::uint32_t, MemorySnapshot::Address> entry;
+      if (!stock_cars.Open(memory, EASTLView::AddressOf(&manager->mStockCars))) return nullptr;
+      if (!stock_cars.Find(memory, key, entry)) return nullptr;
+
+      return reinterpret_cast<ISimable*>(static_cast<std::uintptr_t>(entry.second));
+    }
+  }  // namespace GManagerEx
+
+  //             //
+  // ActionQueue //
+  //             //
+
+  namespace ActionQueueEx {
+    // Slots in a game action queue, 0 if it looks uninitialized
+    static std::int32_t GetCapacity(const ActionQueue* queue) {
+      const auto& fqueue = queue->fQueue;
+      if (fqueue.MaxSize <= 0 || fqueue.MaxSize > static_cast<std::int32_t>(std::size(fqueue.Elements))) return 0;
+
+      return fqueue.MaxSize;
+    }
+    // Free slots in a game action queue, 0 if it looks uninitialized
+    static std::int32_t GetFreeSpace(const ActionQueue* queue) {
+      const auto capacity = GetCapacity(queue);
+      return capacity ? std::max(capacity - queue->fQueue.Size, 0) : 0;
+    }
+
+    // Append to a game action queue the same way UCircularQueue does (write at Tail), game thread only
+    static bool Enqueue(ActionQueue* queue, const ActionData& action) {
+      if (GetFreeSpace(queue) == 0) return false;
+
+      auto& fqueue                 = queue->fQueue;
+      fqueue.Elements[fqueue.Tail] = action;
+      fqueue.Tail                  = (fqueue.Tail + 1) % fqueue.MaxSize;
+      fqueue.Size++;
+      return true;
+    }
+    // Returns how many actions fit, the rest are left out
+    static std::size_t Enqueue(ActionQueue* queue, const ActionData* actions, std::size_t count) {
+      std::size_t added = 0;
+      while (added < count && Enqueue(queue, actions[added])) added++;
+
+      return added;
+    }
+
+    // Collects actions from any thread and hands them to a game queue from the game thread, keeping their order.
+    // Everything posted since the last Flush() lands in the same frame instead of one action per frame callback.
+    // Usage: injector.Post({ActionData::ActionID::GAMEACTION_GAS, 0, 1.0f}); then injector.Flush(queue) in a hook
+    class Injector {
+      // The first action of every Post() carries the size of its batch, the rest 0
+      struct Pending {
+        std::uint32_t mBatchSize;
+        ActionData    mAction;
+      };
+
+      LockFreeQueue::Queue<Pending, 256> mPending;
+      std::atomic<std::uint32_t>         mOverflowCount{0};
+
+     public:
+      // Any thread; false if the pending ring is full, the action is dropped and counted as an overflow
+      bool Post(const ActionData& action) { return Post(&action, 1); }
+      // Any thread; the actions stay together and in order, or none are posted
+      bool Post(const ActionData* actions, std::size_t count) {
+        if (count == 0) return true;
+
+        Pending batch[decltype(mPending)::kCapacity];
+        if (count <= std::size(batch)) {
+          for (std::size_t i = 0; i < count; i++) batch[i] = {i ? 0u : static_cast<std::uint32_t>(count), actions[i]};
+          if (mPending.TryPush(batch, count)) return true;
+        }
+
+        mOverflowCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+
+      // Game thread, before the queue is consumed. Moves whole batches while they fit into 'queue', the first one
+      // that doesn't waits for the next Flush() with everything behind it, so nothing is split or reordered.
+      // A batch bigger than the whole game queue can never fit, it is dropped and counted as an overflow.
+      // Returns how many actions were moved.
+      std::size_t Flush(ActionQueue* queue) {
+        if (!queue || !MemoryEditor::Get().ValidateMemoryIsInitialized(queue)) return 0;
+
+        const auto  capacity = static_cast<std::uint32_t>(GetCapacity(queue));
+        std::size_t moved    = 0;
+        Pending     pending;
+        while (capacity && mPending.TryPeek(pending)) {
+          const auto size = pending.mBatchSize;
+          const bool drop = size > capacity;
+          if (!drop && size > static_cast<std::uint32_t>(GetFreeSpace(queue))) break;
+
+          // The whole batch is published once its first action is, so none of these pops fail
+          for (std::uint32_t i = 0; i < size && mPending.TryPop(pending); i++)
+            if (!drop) Enqueue(queue, pending.mAction);
+
+          if (drop)
+            mOverflowCount.fetch_add(1, std::memory_order_relaxed);
+          else
+            moved += size;
+        }
+        return moved;
+      }
+
+      std::size_t   GetPendingCount() const { return mPending.GetSize(); }
+      std::uint32_t GetOverflowCount() const { return mOverflowCount.load(std::memory_order_relaxed); }
+    };
+  }  // namespace ActionQueueEx
+
+  //        //
+  // Attrib //
+  //        //
+
+  namespace AttribEx {
+    namespace details {
+      // Bumped by NotifyVaultsChanged()
+      static inline std::atomic<std::uint32_t> g_mVaultLoadCount{0};
+
+      // Changes whenever GManager loads or unloads a vault. A vault reloaded into the slot it was unloaded from
+      // looks the same to GManager, only the load count tells those apart.
+      static std::uint64_t GetVaultSignature() {
+        auto* gmanager = GManager::Get();
+        if (!gmanager) return 0;
+
+        std::uint64_t signature = 0xCBF29CE484222325;
+        for (std::uintptr_t v : {reinterpret_cast<std::uintptr_t>(gmanager), std::uintptr_t(gmanager->mVaultCount),
+                                 reinterpret_cast<std::uintptr_t>(gmanager->mVaults),
+                                 reinterpret_cast<std::uintptr_t>(gmanager->mLoadingPackImage),
+                                 reinterpret_cast<std::uintptr_t>(gmanager->mStreamedBinSlots),
+                                 std::uintptr_t(gmanager->mBinSlotSize),
+                                 reinterpret_cast<std::uintptr_t>(gmanager->mBinVaultInSlot[0]),
+                                 reinterpret_cast<std::uintptr_t>(gmanager->mStreamedRaceSlots),
+                                 std::uintptr_t(gmanager->mRaceSlotSize),
+                                 reinterpret_cast<std::uintptr_t>(gmanager->mRaceVaultInSlot[0]),
+                                 std::uintptr_t(g_mVaultLoadCount.load(std::memory_order_acquire))})
+          signature = (signature ^ v) * 0x100000001B3;
+        return signature;
+      }
+
+      template <typename T>
+      struct VaultCache {
+        GenerationCache::Table<T>  mTable;
+        std::atomic<std::uint64_t> mVaultSignature{0};
+
+        explicit VaultCache(std::uint32_t capacity) : mTable(capacity) {}
+
+        // Bump the generation once per vault change, whichever thread notices first
+        void Validate() {
+          auto signature = GetVaultSignature();
+          auto previous  = mVaultSignature.load(std::memory_order_acquire);
+          if (signature != previous && mVaultSignature.compare_exchange_strong(previous, signature))
+            mTable.Invalidate();
+        }
+      };
+      static inline VaultCache<Attrib::Collection*> g_mCollectionCache(8192);
+
+      // A reader may still hold a table from before an invalidation, so tables are only freed once vaults have
+      // changed twice since they were built
+      struct AccessorCache : VaultCache<const AttribAccessor::Table*> {
+        struct Built {
+          std::uint32_t                          mGeneration;
+          std::uint32_t                          mKey;
+          std::unique_ptr<AttribAccessor::Table> mTable;
+        };
+
+        std::mutex         mBuildMutex;
+        std::vector<Built> mTables;
+
+        AccessorCache() : VaultCache(512) {}
+
+        // Under mBuildMutex; the table built for 'key' in 'generation', even if it didn't fit the lookup table
+        const AttribAccessor::Table* FindBuilt(std::uint32_t key, std::uint32_t generation) const {
+          for (const auto& built : mTables)
+            if (built.mGeneration == generation && built.mKey == key) return built.mTable.get();
+          return nullptr;
+        }
+        // Under mBuildMutex
+        void Retire(std::uint32_t generation) {
+          mTables.erase(std::remove_if(mTables.begin(), mTables.end(),
+                                       [=](const Built& built) { return generation - built.mGeneration > 1; }),
+                        mTables.end());
+        }
+      };
+      static inline AccessorCache g_mAccessorCache;
+
+      // Views live in the arena of their generation's parity, so a view stays readable until vaults change twice
+      struct FlatViewCache : VaultCache<const AttribFlatView::View*> {
+        std::mutex            mBuildMutex;
+        ArenaAllocator::Arena mArenas[2];
+        std::uint32_t         mArenaGenerations[2] = {};
+
+        FlatViewCache() : VaultCache(4096) {}
+
+        // Under mBuildMutex with the current generation. An arena is only reset to move it to a newer generation,
+        // which leaves the previous generation's views alone.
+        ArenaAllocator::Arena& GetArena(std::uint32_t generation) {
+          const auto idx = generation & 1;
+          if (mArenaGenerations[idx] != generation) {
+            mArenas[idx].Reset();
+            mArenaGenerations[idx] = generation;
+          }
+          return mArenas[idx];
+        }
+      };
+      static inline FlatViewCache g_mFlatViewCache;
+
+      static std::uint64_t ToCacheKey(Attrib::StringKey classKey, Attrib::StringKey collectionKey) {
+        return (static_cast<std::uint64_t>(classKey) << 32) | collectionKey;
+      }
+    }  // namespace details
+
+    // Invalidate every Attrib cache on the next lookup; call it from a hook on the game's vault load/unload so
+    // reloading a vault into the same slot is never missed
+    static void NotifyVaultsChanged() { details::g_mVaultLoadCount.fetch_add(1, std::memory_order_release); }
+
+    // Drop every cached collection, e.g. after editing vaults by hand
+    static void InvalidateCollectionCache() { details::g_mCollectionCache.mTable.Invalidate(); }
+
+    // Cached Attrib::FindCollection, reads are lock-free and safe from the render thread
+    static Attrib::Collection* FindCollection(Attrib::StringKey classKey, Attrib::StringKey collectionKey) {
+      auto& cache = details::g_mCollectionCache;
+      cache.Validate();
+      return cache.mTable.GetOrAdd(details::ToCacheKey(classKey, collectionKey),
+                                   [=] { return Attrib::FindCollection(classKey, collectionKey); });
+    }
+    // Cached Attrib::Class::GetCollection
+    static Attrib::Collection* GetCollection(Attrib::Class* cls, Attrib::StringKey collectionKey) {
+      if (!cls) return nullptr;
+
+      auto& cache = details::g_mCollectionCache;
+      cache.Validate();
+      return cache.mTable.GetOrAdd(details::ToCacheKey(cls->mKey, collectionKey),
+                                   [=] { return cls->GetCollection(collectionKey); });
+    }
+
+    // Key to field table of 'cls', built from its definitions on first use and after vault changes
+    static const AttribAccessor::Table* GetAccessorTable(Attrib::Class* cls) {
+      if (!cls) return nullptr;
+
+      auto& cache = details::g_mAccessorCache;
+      cache.Validate();
+
+      const AttribAccessor::Table* table = nullptr;
+      if (cache.mTable.Find(cls->mKey, table)) return table;
+
+      // Another thread may have built it while this one waited
+      std::scoped_lock _lock(cache.mBuildMutex);
+      const auto       generation = cache.mTable.GetGeneration();
+      if (cache.mTable.Find(cls->mKey, table)) return table;
+
+      cache.Retire(generation);
+      table = cache.FindBuilt(cls->mKey, generation);
+      if (!table) {
+        cache.mTables.push_back({generation, cls->mKey, std::make_unique<AttribAccessor::Table>(*cls)});
+        table = cache.mTables.back().mTable.get();
+      }
+      cache.mTable.Insert(cls->mKey, table, generation);
+      return table;
+    }
+    // Collection::GetData, a pointer add into the layout for laid out fields
+    template <typename T>
+    static T* GetData(Attrib::Collection* collection, Attrib::StringKey key, std::uint32_t idx = 0) {
+      if (!collection) return nullptr;
+
+      auto fallback = [=] { return collection->GetData<T>(key, static_cast<std::int32_t>(idx)); };
+      auto* table   = GetAccessorTable(collection->mClass);
+      return table ? table->GetData<T>(collection->mLayout, key, idx, fallback) : fallback();
+    }
+    static std::uint32_t GetCount(Attrib::Collection* collection, Attrib::StringKey key) {
+      if (!collection) return 0;
+
+      auto fallback = [=] { return collection->GetCount(key); };
+      auto* table   = GetAccessorTable(collection->mClass);
+      return table ? table->GetCount(collection->mLayout, key, fallback) : fallback();
+    }
+
+    // 'collection' with its parents merged into one table, built on first use and after vault changes. Built by
+    // reading the tables natively like Collection::GetDataNative(), so just as unverified.
+    static const AttribFlatView::View* GetFlatViewNative(Attrib::Collection* collection) {
+      if (!collection || !collection->mClass) return nullptr;
+
+      auto& cache = details::g_mFlatViewCache;
+      cache.Validate();
+
+      const AttribFlatView::View* view = nullptr;
+      if (cache.mTable.Find(reinterpret_cast<std::uintptr_t>(collection), view)) return view;
+
+      // The generation is read under the lock, a thread that waited must not build into an arena it outdated
+      std::scoped_lock _lock(cache.mBuildMutex);
+      const auto       generation = cache.mTable.GetGeneration();
+      if (cache.mTable.Find(reinterpret_cast<std::uintptr_t>(collection), view)) return view;
+
+      view = AttribFlatView::Build(cache.GetArena(generation), MemorySnapshot::LiveMemory{}, collection->GetAddress(),
+                                   *collection->mClass);
+      cache.mTable.Insert(reinterpret_cast<std::uintptr_t>(collection), view, generation);
+      return view;
+    }
+    // Collection::GetData through the flattened view, no parent walks; unverified, see GetFlatViewNative(). Keys
+    // the view doesn't resolve go to the game's Collection::GetData.
+    template <typename T>
+    static T* GetFlatDataNative(Attrib::Collection* collection, Attrib::StringKey key, std::uint32_t idx = 0) {
+      if (!collection) return nullptr;
+
+      auto* view    = GetFlatViewNative(collection);
+      auto  address = view ? view->GetDataAddress(MemorySnapshot::LiveMemory{}, key, idx) : 0;
+      if (!address) return collection->GetData<T>(key, static_cast<std::int32_t>(idx));
+
+      return reinterpret_cast<T*>(static_cast<std::uintptr_t>(address));
+    }
+
+    // Live database source for AttribColumnar::Export, shaped like VaultReader's classes and collections
+    // Usage: AttribColumnar::Export(os, AttribEx::ColumnarSource({"pvehicle"_key, "presetride"_key}));
+    class ColumnarSource {
+     public:
+      // Reads go through game code that isn't thread-safe, so Export() and Diff() stay on the calling thread
+      static constexpr bool kIsSnapshot = false;
+
+      class Collection {
+        Attrib::Collection* mCollection;
+
+       public:
+        explicit Collection(Attrib::Collection* collection = nullptr) : mCollection(collection) {}
+
+        bool          IsValid() const { return mCollection != nullptr; }
+        std::uint32_t GetKey() const { return mCollection->mKey; }
+        std::uint32_t GetCount(Attrib::StringKey key) const { return mCollection->GetCount(key); }
+        template <typename T>
+        const T* GetData(Attrib::StringKey key, std::uint32_t idx = 0) const {
+          return mCollection->GetData<T>(key, static_cast<std::int32_t>(idx));
+        }
+      };
+      class Class {
+        Attrib::Class* mClass;
+
+       public:
+        explicit Class(Attrib::Class* cls) : mClass(cls) {}
+
+        std::uint32_t GetKey() const { return mClass->mKey; }
+        std::uint32_t GetNumCollections() const { return mClass->GetNumCollections(); }
+        std::uint32_t GetFirstCollection() const { return mClass->GetFirstCollection(); }
+        std::uint32_t GetNextCollection(Attrib::StringKey key) const { return mClass->GetNextCollection(key); }
+        Collection    GetCollection(Attrib::StringKey key) const {
+          return Collection(AttribEx::GetCollection(mClass, key));
+        }
+        std::uint32_t GetNumDefinitions() const { return mClass->GetNumDefinitions(); }
+        std::uint32_t GetFirstDefinition() const { return mClass->GetFirstDefinition(); }
+        std::uint32_t GetNextDefinition(Attrib::StringKey key) const { return mClass->GetNextDefinition(key); }
+        const Attrib::Definition* GetDefinition(Attrib::StringKey key) const { return mClass->GetDefinition(key); }
+      };
+
+      // The game can't enumerate its classes, so they're listed; unknown keys are skipped
+      explicit ColumnarSource(std::initializer_list<Attrib::StringKey> classKeys) {
+        auto* database = Attrib::Database::Get();
+        if (!database) return;
+
+        for (auto key : classKeys)
+          if (auto* cls = database->GetClass(key)) mClasses.emplace_back(cls);
+      }
+
+      template <typename Fn>
+      void ForEachClass(Fn&& fn) const {
+        for (const auto& cls : mClasses) fn(cls);
+      }
+      const char* ResolveString(const Collection&, const std::uint8_t* field) const {
+        return *reinterpret_cast<const char* const*>(field);
+      }
+
+     private:
+      std::vector<Class> mClasses;
+    };
+  }  // namespace AttribEx
 }  // namespace OpenSpeed::MW05
@@ -58,7 +58,7 @@ namespace OpenSpeed::MW05 {
     std::int32_t                 mNumCopsForLatchedRoadblockReq;
     IPursuit*                    mIPursuitWithLatchedRoadblockReq;
     IVehicle*                    mPursuitRequestVehicle;
-    UTL::List<IVehicle*, 10>     mIVehicleList;
+    UTL::List<IVehicle, 10>      mIVehicleList;
     eastl::list<IPursuit*>       mIPursuitList;
     eastl::list<IRoadBlock*>     mRoadBlockList;
     ActionQueue*                 mActionQ;
@@ -39,7 +39,7 @@ namespace OpenSpeed::MW05 {
 
     HSIMTASK__*                             mSimulateTask;
     HSIMTASK__*                             mBustedTimerTask;
-    UTL::List<IVehicle*, 10>                mIVehicleList;
+    UTL::List<IVehicle, 10>                 mIVehicleList;
     AITarget*                               mTarget;
     IVehicle*                               mNearestCopInRoadblock;
     float                                   mDistanceToNearestCopInRoadblock;
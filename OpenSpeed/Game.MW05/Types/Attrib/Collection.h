@@ -18,6 +18,8 @@
 // clang-format on
 
 #pragma once
+#include <OpenSpeed/Core/AttribReader/AttribReader.hpp>  // AttribReader::GetDataAddress
+
 #include <OpenSpeed/Game.MW05/Types.h>
 #include <OpenSpeed/Game.MW05/Types/Attrib/HashMap.h>
 
@@ -36,6 +38,32 @@ namespace OpenSpeed::MW05::Attrib {
     inline T* GetData(StringKey fieldKey, std::int32_t idx = 0) {
       return reinterpret_cast<T*(__thiscall*)(Collection*, StringKey, std::int32_t)>(0x454190)(this, fieldKey, idx);
     }
+    // Elements GetData() returns for 'fieldKey', probed through the game call up to GetCountNative() (at least one),
+    // so counts and data always come from the same lookup
+    inline std::uint32_t GetCount(StringKey fieldKey) {
+      auto bound = GetCountNative(fieldKey);
+      if (!bound) bound = 1;
+
+      std::uint32_t count = 0;
+      while (count < bound && GetData<void>(fieldKey, static_cast<std::int32_t>(count))) count++;
+      return count;
+    }
+
+    // Collection::GetData (0x454190) read natively, walking mParent when the key isn't in this table. The slot
+    // formula and array padding aren't checked against the game yet, prefer GetData() until they are.
+    template <typename T>
+    inline T* GetDataNative(StringKey fieldKey, std::int32_t idx = 0) {
+      auto address = AttribReader::GetDataAddress(MemorySnapshot::LiveMemory{}, GetAddress(), fieldKey,
+                                                  static_cast<std::uint32_t>(idx));
+      return reinterpret_cast<T*>(static_cast<std::uintptr_t>(address));
+    }
+    // Only a hint while the native reads are unverified, GetCount() checks it against GetData()
+    inline std::uint32_t GetCountNative(StringKey fieldKey) {
+      return AttribReader::GetCount(MemorySnapshot::LiveMemory{}, GetAddress(), fieldKey);
+    }
+    inline MemorySnapshot::Address GetAddress() {
+      return static_cast<MemorySnapshot::Address>(reinterpret_cast<std::uintptr_t>(this));
+    }
 
     template <typename T>
     inline T* GetLayout() {
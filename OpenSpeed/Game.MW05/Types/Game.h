@@ -18,6 +18,8 @@
 // clang-format on
 
 #pragma once
+#include <OpenSpeed/Core/Hashing/Hashing.hpp>  // Hashing::BStringHash, Hashing::StringHash32
+
 #include <OpenSpeed/Game.MW05/Types.h>
 
 namespace OpenSpeed::MW05::Game {
@@ -67,13 +69,9 @@ namespace OpenSpeed::MW05::Game {
   // Game_ShowPauseMenu
   static inline void ShowPauseMenu() { reinterpret_cast<void(__cdecl*)()>(0x6050F0)(); }
 
-  // custom hashing
-  static inline std::uint32_t bStringHash(const char* cstring) {
-    return reinterpret_cast<std::uint32_t(__cdecl*)(const char*)>(0x460BF0)(cstring);
-  }
+  // custom hashing, native bStringHash (0x460BF0)
+  static constexpr std::uint32_t bStringHash(const char* cstring) { return Hashing::BStringHash(cstring); }
 
-  // uses 0xABCDEF00 magic
-  static inline std::uint32_t stringhash32(const char* cstring) {
-    return reinterpret_cast<std::uint32_t(__cdecl*)(const char*)>(0x5CC240)(cstring);
-  }
+  // uses 0xABCDEF00 magic, native stringhash32 (0x5CC240)
+  static constexpr std::uint32_t stringhash32(const char* cstring) { return Hashing::StringHash32(cstring); }
 }  // namespace OpenSpeed::MW05::Game
@@ -27,11 +27,11 @@ namespace OpenSpeed::MW05 {
   struct GroundSupportRequest {
     enum Status : std::uint32_t { NotActive, Pending, Active };
 
-    const HeavySupport*      mHeavySupport;
-    const LeaderSupport*     mLeaderSupport;
-    UTL::List<IVehicle*, 10> mIVehicleList;
-    eastl::list<char*>       mVehicleGoals;
-    float                    mSupportTimer;
-    Status                   mSupportRequestStatus;
+    const HeavySupport*     mHeavySupport;
+    const LeaderSupport*    mLeaderSupport;
+    UTL::List<IVehicle, 10> mIVehicleList;
+    eastl::list<char*>      mVehicleGoals;
+    float                   mSupportTimer;
+    Status                  mSupportRequestStatus;
   };
 }  // namespace OpenSpeed::MW05
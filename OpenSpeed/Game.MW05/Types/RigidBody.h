@@ -155,7 +155,7 @@ namespace OpenSpeed::MW05 {
       static std::int32_t GetInstancesCount() {
         std::int32_t _amount    = 0;
         auto**       _pInstance = g_mInstances;
-        while ((*_pInstance)++) _amount++;
+        while (*_pInstance++) _amount++;
 
         return _amount;
       }